@@ -0,0 +1,216 @@
+/*
+
+Altitude and azimuth of the Sun, one instant or a whole series of them
+
+The Sun's direction is computed with sun_RA_dec() at the start, middle
+and end of each span of up to one day, and interpolated quadratically
+as a unit vector in equatorial coordinates, in between.  The error of
+that is below 0.00001 degrees.  For series with a fixed step the sidereal
+time is also advanced by rotation, so that each sample costs a few
+multiplications, an asin() and an atan2().
+
+Altitudes are geometric, of the Sun's center, without refraction.
+Azimuths are measured from north through east, 0..360 degrees.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+/* Longest span covered by one set of interpolation coefficients, days */
+#define SPAN  1.0
+
+/* Rotation accumulates round-off, start over from GMST0() this often */
+#define RENORM  1024
+
+/* Quadratic in s = 0..1 over one span, per component of the vector */
+struct span {
+	double d, len;
+	double c0[3], c1[3], c2[3];
+};
+
+/* Unit vector towards the Sun, equatorial coordinates, at d */
+static void direction(double d, double v[3])
+{
+	double RA, dec, r;
+
+	sun_RA_dec(d, &RA, &dec, &r);
+	v[0] = cosd(dec) * cosd(RA);
+	v[1] = cosd(dec) * sind(RA);
+	v[2] = sind(dec);
+}
+
+static void span_init(struct span *sp, double d, double len)
+{
+	double a[3], b[3], c[3];
+	int i;
+
+	direction(d, a);
+	direction(d + len / 2.0, b);
+	direction(d + len, c);
+
+	sp->d   = d;
+	sp->len = len;
+	for (i = 0; i < 3; i++) {
+		sp->c0[i] = a[i];
+		sp->c1[i] = 4.0 * b[i] - 3.0 * a[i] - c[i];
+		sp->c2[i] = 2.0 * (a[i] + c[i]) - 4.0 * b[i];
+	}
+}
+
+static void span_eval(const struct span *sp, double d, double v[3])
+{
+	double s = (d - sp->d) / sp->len;
+	int i;
+
+	for (i = 0; i < 3; i++)
+		v[i] = sp->c0[i] + s * (sp->c1[i] + s * sp->c2[i]);
+}
+
+/* Local sidereal time, in degrees, at d (UT) and longitude lon */
+static double sidtime(double d, double lon)
+{
+	return revolution(GMST0(d) + 360.0 * (d - floor(d)) + lon);
+}
+
+/*
+ * Horizontal coordinates from the Sun's vector, given the sine and
+ * cosine of the local sidereal time and of the latitude
+ */
+static void horizon(const double v[3], double sinlst, double coslst,
+		    double sinlat, double coslat, double *alt, double *az)
+{
+	double x, y, n;
+
+	/* Rotate to hour angle: x = cos(dec)cos(H), y = cos(dec)sin(H) */
+	x = v[0] * coslst + v[1] * sinlst;
+	y = v[0] * sinlst - v[1] * coslst;
+
+	/* Interpolation leaves the vector a little short of unit length */
+	n = sqrt(x * x + y * y + v[2] * v[2]);
+
+	*alt = asind((v[2] * sinlat + x * coslat) / n);
+	*az  = revolution(180.0 + atan2d(y, x * sinlat - v[2] * coslat));
+}
+
+void sun_alt_az( double d, double lon, double lat, double *alt, double *az )
+{
+	double v[3], lst;
+
+	direction(d, v);
+	lst = sidtime(d, lon);
+	horizon(v, sind(lst), cosd(lst), sind(lat), cosd(lat), alt, az);
+}
+
+void sun_alt_az_series( double d, double step, size_t n, double lon, double lat,
+			double *alt, double *az )
+{
+	double sinlat = sind(lat), coslat = cosd(lat);
+	double sinstep, cosstep, sinlst = 0.0, coslst = 1.0;
+	struct span sp;
+	size_t i, k = 0;
+
+	if (!n)
+		return;
+
+	/* Sidereal time runs 360.9856 degrees per day, GMST0() + 360 */
+	sinstep = sind((360.0 + 0.9856002585 + 4.70935E-5) * step);
+	cosstep = cosd((360.0 + 0.9856002585 + 4.70935E-5) * step);
+
+	sp.d = d;
+	sp.len = -1.0;
+	for (i = 0; i < n; i++) {
+		double t = d + i * step, v[3];
+
+		if (t < sp.d || t > sp.d + sp.len) {
+			double len = SPAN;
+
+			if ((n - 1 - i) * fabs(step) < len)
+				len = (n - 1 - i) * fabs(step);
+			if (len <= 0.0)
+				len = fabs(step) > 0.0 ? fabs(step) : SPAN;
+			span_init(&sp, step < 0.0 ? t - len : t, len);
+		}
+
+		if (k-- == 0) {
+			double lst = sidtime(t, lon);
+
+			sinlst = sind(lst);
+			coslst = cosd(lst);
+			k = RENORM - 1;
+		} else {
+			double s = sinlst;
+
+			sinlst = s * cosstep + coslst * sinstep;
+			coslst = coslst * cosstep - s * sinstep;
+		}
+
+		span_eval(&sp, t, v);
+		horizon(v, sinlst, coslst, sinlat, coslat, &alt[i], &az[i]);
+	}
+}
+
+/*
+ * Samples at arbitrary instants, d[] in days since 2000 Jan 0.0 UT.
+ * Interpolation spans are reused as long as the samples fall in them,
+ * so sorted input is cheapest, but any order works.
+ */
+static void series(struct span *sp, const double *d, size_t n, double lon,
+		   double lat, double *alt, double *az)
+{
+	double sinlat = sind(lat), coslat = cosd(lat);
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		double v[3], lst;
+
+		if (d[i] < sp->d || d[i] > sp->d + sp->len)
+			span_init(sp, d[i], SPAN);
+
+		lst = sidtime(d[i], lon);
+		span_eval(sp, d[i], v);
+		horizon(v, sind(lst), cosd(lst), sinlat, coslat, &alt[i], &az[i]);
+	}
+}
+
+#define CHUNK 256
+
+void sun_alt_az_jd( const double *jd, size_t n, double lon, double lat,
+		    double *alt, double *az )
+{
+	struct span sp = { .len = -1.0 };
+	double d[CHUNK];
+	size_t i, j, m;
+
+	for (i = 0; i < n; i += m) {
+		m = n - i < CHUNK ? n - i : CHUNK;
+		for (j = 0; j < m; j++)
+			d[j] = jd[i + j] - 2451543.5;
+		series(&sp, d, m, lon, lat, alt + i, az + i);
+	}
+}
+
+void sun_alt_az_time( const time_t *t, size_t n, double lon, double lat,
+		      double *alt, double *az )
+{
+	struct span sp = { .len = -1.0 };
+	double d[CHUNK];
+	size_t i, j, m;
+
+	/* The UNIX epoch, 1970 Jan 1.0 UT, is day -10956 */
+	for (i = 0; i < n; i += m) {
+		m = n - i < CHUNK ? n - i : CHUNK;
+		for (j = 0; j < m; j++)
+			d[j] = t[i + j] / 86400.0 - 10956.0;
+		series(&sp, d, m, lon, lat, alt + i, az + i);
+	}
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,590 @@
+/*
+
+Streaming batch mode for the SUNRISET front-end application
+
+Reads one location and date per line from stdin, as CSV or NDJSON:
+
+	59.33,18.07,2025-06-21
+	{"lat": 59.33, "lon": 18.07, "date": "2025-06-21"}
+
+and writes each row back, in input order, with sunrise, sunset and day
+length appended as HH:MM, in local time or UT:
+
+	59.33,18.07,2025-06-21,03:30,22:08,18:37
+	{"lat":59.33,"lon":18.07,"date":"2025-06-21","rise":"03:30",...}
+
+A first CSV line that does not start with a number is taken to be a
+header.  When stdin is a regular file it is mapped, otherwise it is read
+in blocks.  Either way the input is cut into windows at line boundaries,
+each window is split into equal byte ranges, one per worker thread, and
+each worker finds the line starts of its own range, parses the fields
+in place and formats into a buffer of its own.  The buffers are then
+written in worker order, which is input order.  Nothing in the workers
+touches the global state of sun.c, and the times are formatted with a
+table of two digit numbers rather than snprintf().
+
+Released to the public domain
+
+ */
+#include "config.h"
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "batch.h"
+#include "sunriset.h"
+
+/* Input bytes per worker and window */
+#define WINDOW  (1 << 20)
+
+/* Longest output line, not counting the input row itself */
+#define EXTRA   64
+
+struct buf {
+	char   *data;
+	size_t  len;
+	size_t  size;
+};
+
+struct worker {
+	pthread_t   id;
+	const char *start;	/* Range of input, whole lines after fixup */
+	const char *end;
+	struct buf  out;
+	size_t      errors;
+};
+
+static struct worker *workers;
+static int            nworkers;
+static int            quit;
+
+static pthread_barrier_t go, done;
+static pthread_mutex_t   startup = PTHREAD_MUTEX_INITIALIZER;
+
+static const sunriset_tz *zone;
+static long               gmtoff;
+
+static const char digits[] =
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859";
+
+/* Minutes into the day as HH:MM, no NUL */
+static char *hhmm(char *p, int min)
+{
+	int h = min / 60, m = min % 60;
+
+	memcpy(p, &digits[2 * h], 2);
+	p[2] = ':';
+	memcpy(p + 3, &digits[2 * m], 2);
+
+	return p + 5;
+}
+
+/* Hours UT from 0h UT of day, to minutes into the local day */
+static int local(time_t day, double ut)
+{
+	long min, off = gmtoff;
+
+	if (zone)
+		off = sunriset_tz_offset(zone, day + (time_t)(ut * 3600.0), NULL);
+
+	min = (long)floor(ut * 60.0) + off / 60;
+	min %= 24 * 60;
+	if (min < 0)
+		min += 24 * 60;
+
+	return (int)min;
+}
+
+/* Plain decimal number, bounded by end, the input need not be terminated */
+static const char *number(const char *p, const char *end, double *val)
+{
+	double v = 0.0, scale = 1.0;
+	int neg = 0, any = 0;
+
+	while (p < end && (*p == ' ' || *p == '\t'))
+		p++;
+	if (p < end && (*p == '-' || *p == '+'))
+		neg = *p++ == '-';
+	while (p < end && *p >= '0' && *p <= '9') {
+		v = v * 10.0 + (*p++ - '0');
+		any = 1;
+	}
+	if (p < end && *p == '.') {
+		for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+			scale /= 10.0;
+			v += (*p - '0') * scale;
+			any = 1;
+		}
+	}
+	if (!any)
+		return NULL;
+
+	*val = neg ? -v : v;
+	return p;
+}
+
+static const char *integer(const char *p, const char *end, int ndigits, int *val)
+{
+	int v = 0;
+
+	while (ndigits--) {
+		if (p >= end || *p < '0' || *p > '9')
+			return NULL;
+		v = v * 10 + (*p++ - '0');
+	}
+
+	*val = v;
+	return p;
+}
+
+static int mdays(int year, int month)
+{
+	static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+
+	return days[month - 1] + (month == 2 ? leap : 0);
+}
+
+/* YYYY-MM-DD */
+static const char *date(const char *p, const char *end, int *year, int *month, int *day)
+{
+	while (p < end && (*p == ' ' || *p == '\t'))
+		p++;
+
+	p = integer(p, end, 4, year);
+	if (!p || p >= end || *p++ != '-')
+		return NULL;
+	p = integer(p, end, 2, month);
+	if (!p || p >= end || *p++ != '-')
+		return NULL;
+	p = integer(p, end, 2, day);
+	if (!p || *month < 1 || *month > 12 || *day < 1 || *day > mdays(*year, *month))
+		return NULL;
+
+	return p;
+}
+
+static const char *skip(const char *p, const char *end, char c)
+{
+	while (p < end && (*p == ' ' || *p == '\t'))
+		p++;
+	if (p >= end || *p != c)
+		return NULL;
+
+	return p + 1;
+}
+
+static int parse_csv(const char *p, const char *end, double *lat, double *lon,
+		     int *year, int *month, int *day)
+{
+	p = number(p, end, lat);
+	if (p)
+		p = skip(p, end, ',');
+	if (p)
+		p = number(p, end, lon);
+	if (p)
+		p = skip(p, end, ',');
+	if (p)
+		p = date(p, end, year, month, day);
+
+	return p != NULL;
+}
+
+/* Value of "key" in a flat JSON object */
+static const char *value(const char *p, const char *end, const char *key)
+{
+	size_t len = strlen(key);
+
+	while (p && p + len + 2 <= end) {
+		p = memchr(p, '"', end - p);
+		if (!p || p + len + 2 > end)
+			return NULL;
+		if (!memcmp(p + 1, key, len) && p[len + 1] == '"')
+			return skip(p + len + 2, end, ':');
+		p++;
+	}
+
+	return NULL;
+}
+
+static int parse_json(const char *p, const char *end, double *lat, double *lon,
+		      int *year, int *month, int *day)
+{
+	const char *v;
+
+	v = value(p, end, "lat");
+	if (!v || !number(v, end, lat))
+		return 0;
+	v = value(p, end, "lon");
+	if (!v || !number(v, end, lon))
+		return 0;
+	v = value(p, end, "date");
+	if (v)
+		v = skip(v, end, '"');
+	if (!v || !date(v, end, year, month, day))
+		return 0;
+
+	return 1;
+}
+
+static int reserve(struct buf *b, size_t len)
+{
+	char *data;
+	size_t size;
+
+	if (b->len + len <= b->size)
+		return 1;
+
+	size = b->size ? b->size : 2 * WINDOW;
+	while (size < b->len + len)
+		size *= 2;
+	data = realloc(b->data, size);
+	if (!data)
+		return 0;
+
+	b->data = data;
+	b->size = size;
+	return 1;
+}
+
+static void row(struct worker *w, const char *line, const char *end)
+{
+	double lat, lon, rise, set;
+	int year, month, day, json, rc, len;
+	time_t midnight;
+	char *p;
+
+	while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+		end--;
+	if (end == line || *line == '#')
+		return;
+
+	json = *line == '{';
+	if (json)
+		rc = parse_json(line, end, &lat, &lon, &year, &month, &day);
+	else
+		rc = parse_csv(line, end, &lat, &lon, &year, &month, &day);
+	if (!rc || lat < -90.0 || lat > 90.0) {
+		w->errors++;
+		return;
+	}
+
+	rc = sun_rise_set(year, month, day, lon, lat, &rise, &set);
+	midnight = ((time_t)days_since_2000_Jan_0(year, month, day) + 10956) * 86400;
+
+	if (!reserve(&w->out, (end - line) + EXTRA)) {
+		w->errors++;
+		return;
+	}
+	p = &w->out.data[w->out.len];
+
+	/* The input row as is, less the closing brace of an object */
+	if (json) {
+		while (end > line && end[-1] != '}')
+			end--;
+		if (end > line)
+			end--;
+	}
+	len = end - line;
+	memcpy(p, line, len);
+	p += len;
+
+	if (json) {
+		if (rc) {
+			memcpy(p, ",\"rise\":null,\"set\":null,\"daylen\":\"", 34);
+			p += 34;
+		} else {
+			memcpy(p, ",\"rise\":\"", 9);
+			p = hhmm(p + 9, local(midnight, rise));
+			memcpy(p, "\",\"set\":\"", 9);
+			p = hhmm(p + 9, local(midnight, set));
+			memcpy(p, "\",\"daylen\":\"", 12);
+			p += 12;
+		}
+	} else {
+		*p++ = ',';
+		if (!rc)
+			p = hhmm(p, local(midnight, rise));
+		*p++ = ',';
+		if (!rc)
+			p = hhmm(p, local(midnight, set));
+		*p++ = ',';
+	}
+
+	/* Sun always above, or below, the horizon */
+	if (rc)
+		p = hhmm(p, rc > 0 ? 24 * 60 : 0);
+	else
+		p = hhmm(p, (int)((set - rise) * 60.0 + 0.5));
+
+	if (json) {
+		*p++ = '"';
+		*p++ = '}';
+	}
+	*p++ = '\n';
+
+	w->out.len = p - w->out.data;
+}
+
+static void work(struct worker *w)
+{
+	const char *p = w->start;
+
+	w->out.len = 0;
+	while (p < w->end) {
+		const char *nl = memchr(p, '\n', w->end - p);
+
+		if (!nl)
+			nl = w->end;
+		row(w, p, nl);
+		p = nl + 1;
+	}
+}
+
+static void *worker(void *arg)
+{
+	struct worker *w = arg;
+
+	/* Until the barriers are sized to the threads actually started */
+	pthread_mutex_lock(&startup);
+	pthread_mutex_unlock(&startup);
+
+	while (1) {
+		pthread_barrier_wait(&go);
+		if (quit)
+			break;
+		work(w);
+		pthread_barrier_wait(&done);
+	}
+
+	return NULL;
+}
+
+/*
+ * Process a window of whole lines: split it in byte ranges, move each
+ * range start past the next line break, run the workers, and write
+ * their output in order
+ */
+static int process(const char *buf, size_t len)
+{
+	const char *end = buf + len;
+	int i;
+
+	for (i = 0; i < nworkers; i++) {
+		const char *p = buf + len / nworkers * i;
+
+		if (i > 0 && p > buf && p[-1] != '\n') {
+			p = memchr(p, '\n', end - p);
+			p = p ? p + 1 : end;
+		}
+		workers[i].start = p;
+	}
+	for (i = 0; i < nworkers; i++)
+		workers[i].end = i + 1 < nworkers ? workers[i + 1].start : end;
+
+	pthread_barrier_wait(&go);
+	pthread_barrier_wait(&done);
+
+	for (i = 0; i < nworkers; i++) {
+		if (fwrite(workers[i].out.data, 1, workers[i].out.len, stdout) != workers[i].out.len)
+			return 0;
+	}
+
+	return 1;
+}
+
+/* CSV header, passed through with the new columns added */
+static size_t header(const char *buf, size_t len)
+{
+	const char *nl;
+	size_t n;
+
+	if (!len || *buf == '{' || *buf == '#' || *buf == '-' || *buf == '+' ||
+	    *buf == '.' || (*buf >= '0' && *buf <= '9'))
+		return 0;
+
+	nl = memchr(buf, '\n', len);
+	n = nl ? (size_t)(nl - buf) : len;
+	while (n > 0 && buf[n - 1] == '\r')
+		n--;
+	fwrite(buf, 1, n, stdout);
+	fputs(",rise,set,daylen\n", stdout);
+
+	return nl ? (size_t)(nl - buf) + 1 : len;
+}
+
+static int mapped(int fd, size_t size)
+{
+	const char *map, *p, *end;
+	int rc = 1;
+
+	map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED)
+		return -1;
+	madvise((void *)map, size, MADV_SEQUENTIAL);
+
+	p   = map + header(map, size);
+	end = map + size;
+	while (rc && p < end) {
+		const char *stop = end;
+
+		if ((size_t)(end - p) > (size_t)nworkers * WINDOW) {
+			stop = memchr(p + (size_t)nworkers * WINDOW, '\n',
+				      end - p - (size_t)nworkers * WINDOW);
+			stop = stop ? stop + 1 : end;
+		}
+		rc = process(p, stop - p);
+		p = stop;
+	}
+
+	munmap((void *)map, size);
+	return rc;
+}
+
+static int streamed(int fd)
+{
+	size_t size = (size_t)nworkers * WINDOW, len = 0;
+	char *buf, *tmp;
+	int first = 1, eof = 0, rc = 1;
+
+	buf = malloc(size);
+	if (!buf)
+		return 0;
+
+	while (rc && !eof) {
+		ssize_t num;
+		size_t n;
+
+		num = read(fd, buf + len, size - len);
+		if (num < 0) {
+			if (errno == EINTR)
+				continue;
+			rc = 0;
+			break;
+		}
+		eof = num == 0;
+		len += num;
+		if (len < size && !eof)
+			continue;
+
+		/* Whole lines only, unless at end of input */
+		n = len;
+		if (!eof) {
+			while (n > 0 && buf[n - 1] != '\n')
+				n--;
+			if (n == 0) {
+				/* Line longer than the buffer */
+				tmp = realloc(buf, 2 * size);
+				if (!tmp) {
+					rc = 0;
+					break;
+				}
+				buf   = tmp;
+				size *= 2;
+				continue;
+			}
+		}
+
+		if (first) {
+			size_t skip = header(buf, n);
+
+			memmove(buf, buf + skip, len - skip);
+			len -= skip;
+			n   -= skip;
+			first = 0;
+		}
+
+		rc = process(buf, n);
+		memmove(buf, buf + n, len - n);
+		len -= n;
+	}
+
+	free(buf);
+	return rc;
+}
+
+int batch_run(int threads, const sunriset_tz *tz, long offset)
+{
+	size_t errors = 0;
+	struct stat st;
+	int i, err = 0, rc = -1;
+
+	zone   = tz;
+	gmtoff = offset;
+
+	nworkers = threads > 0 ? threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nworkers < 1)
+		nworkers = 1;
+
+	workers = calloc(nworkers, sizeof(*workers));
+	if (!workers)
+		return 1;
+
+	pthread_mutex_lock(&startup);
+	for (i = 0; i < nworkers; i++) {
+		err = pthread_create(&workers[i].id, NULL, worker, &workers[i]);
+		if (err)
+			break;
+	}
+	pthread_barrier_init(&go, NULL, i + 1);
+	pthread_barrier_init(&done, NULL, i + 1);
+	quit = err != 0;
+	pthread_mutex_unlock(&startup);
+
+	/* Let the workers already started see quit, and wait for them */
+	if (err) {
+		pthread_barrier_wait(&go);
+		while (i-- > 0)
+			pthread_join(workers[i].id, NULL);
+		pthread_barrier_destroy(&go);
+		pthread_barrier_destroy(&done);
+		free(workers);
+		fprintf(stderr, "Failed starting worker threads: %s\n", strerror(err));
+		return 1;
+	}
+
+	if (!fstat(STDIN_FILENO, &st) && S_ISREG(st.st_mode) && st.st_size > 0)
+		rc = mapped(STDIN_FILENO, st.st_size);
+	if (rc < 0)
+		rc = streamed(STDIN_FILENO);
+	if (fflush(stdout))
+		rc = 0;
+
+	quit = 1;
+	pthread_barrier_wait(&go);
+	for (i = 0; i < nworkers; i++) {
+		pthread_join(workers[i].id, NULL);
+		errors += workers[i].errors;
+		free(workers[i].out.data);
+	}
+	pthread_barrier_destroy(&go);
+	pthread_barrier_destroy(&done);
+	free(workers);
+
+	if (!rc) {
+		fprintf(stderr, "Failed reading or writing rows: %s\n", strerror(errno));
+		return 1;
+	}
+	if (errors) {
+		fprintf(stderr, "%zu invalid rows skipped\n", errors);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,22 @@
+/*
+
+Streaming batch mode for the SUNRISET front-end application
+
+Released to the public domain
+
+ */
+#ifndef SUN_BATCH_H_
+#define SUN_BATCH_H_
+
+#include "sunriset.h"
+
+int batch_run(int threads, const sunriset_tz *zone, long gmtoff);
+
+#endif /* SUN_BATCH_H_ */
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,457 @@
+/*
+
+Microbenchmarks for the SUNRISET library
+
+Measures the hot paths over latitude bands, including the polar ones
+where acosd() saturates, and ranges of dates.  One JSON object per line
+on stdout, with ns/call, calls/sec and, on x86, TSC cycles/call.  Build
+and run with `make bench`, which runs both the libm and fast math trig
+variants, and the Chebyshev ephemeris when enabled.
+
+Released to the public domain
+
+ */
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "sunriset.h"
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+#define SITES 1024
+
+#ifdef SUNRISET_FAST_MATH
+#define TRIG "fast-math"
+#else
+#define TRIG "libm"
+#endif
+
+struct band {
+	const char *name;
+	double      min, max;	/* Absolute latitude */
+} bands[] = {
+	{ "tropical",    0.0, 23.4 },
+	{ "temperate",  23.4, 60.0 },
+	{ "near-polar", 60.0, 66.5 },
+	{ "polar",      66.5, 90.0 },
+};
+
+struct span {
+	const char *name;
+	int         first, last;	/* Years */
+} spans[] = {
+	{ "1801-1900", 1801, 1900 },
+	{ "1901-2000", 1901, 2000 },
+	{ "2001-2099", 2001, 2099 },
+};
+
+static struct site {
+	int    year, month, day;
+	double lon, lat, d;
+} site[SITES];
+
+static sunriset_location *locs[SITES];
+static double lons[SITES], lats[SITES], out1[SITES], out2[SITES];
+static int rcs[SITES];
+static volatile double sink;
+static double mintime = 0.2;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned long long ticks(void)
+{
+#ifdef HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static void setup(struct band *b, struct span *s)
+{
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		struct site *p = &site[i];
+
+		p->year  = s->first + rand() % (s->last - s->first + 1);
+		p->month = 1 + rand() % 12;
+		p->day   = 1 + rand() % 28;
+		p->lat   = b->min + (b->max - b->min) * (rand() / (double)RAND_MAX);
+		if (rand() & 1)
+			p->lat = -p->lat;
+		p->lon   = -180.0 + 360.0 * (rand() / (double)RAND_MAX);
+		p->d     = days_since_2000_Jan_0(p->year, p->month, p->day) + 0.5 - p->lon / 360.0;
+
+		lons[i] = p->lon;
+		lats[i] = p->lat;
+
+		sunriset_location_close(locs[i]);
+		locs[i] = sunriset_location_open(p->lon, p->lat, SUNRISET_FAST);
+	}
+}
+
+/* Each function runs one pass over all sites, returns number of calls */
+static long run_sunriset(void)
+{
+	double rise, set, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		__sunriset__(site[i].year, site[i].month, site[i].day, site[i].lon,
+			     site[i].lat, -35.0 / 60.0, 1, &rise, &set);
+		sum += rise + set;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_sunriset_at(void)
+{
+	double rise, set, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		sun_rise_set_at(locs[i], site[i].year, site[i].month, site[i].day, &rise, &set);
+		sum += rise + set;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_refined(void)
+{
+	double rise, set, sum = 0.0;
+	int i, iters;
+
+	for (i = 0; i < SITES; i++) {
+		sunriset_refined(site[i].year, site[i].month, site[i].day, site[i].lon,
+				 site[i].lat, -35.0 / 60.0, 1, 3, &rise, &set, &iters);
+		sum += rise + set + iters;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_precise(void)
+{
+	double rise, set, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		__sunriset_precise__(site[i].year, site[i].month, site[i].day, site[i].lon,
+				     site[i].lat, -35.0 / 60.0, 1, &rise, &set);
+		sum += rise + set;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_daylen(void)
+{
+	double sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++)
+		sum += __daylen__(site[i].year, site[i].month, site[i].day, site[i].lon,
+				  site[i].lat, -35.0 / 60.0, 1);
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_daylen_at(void)
+{
+	double sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++)
+		sum += day_length_at(locs[i], site[i].year, site[i].month, site[i].day);
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_sunpos(void)
+{
+	double lon, r, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		sunpos(site[i].d, &lon, &r);
+		sum += lon + r;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_RA_dec(void)
+{
+	double RA, dec, r, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		sun_RA_dec(site[i].d, &RA, &dec, &r);
+		sum += RA + dec + r;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_position(void)
+{
+	double az, zen, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		sun_position_precise(2451543.5 + site[i].d, 69.0, site[i].lon, site[i].lat,
+				     0.0, 1010.0, 10.0, &az, &zen);
+		sum += az + zen;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_alt_az(void)
+{
+	double alt, az, sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++) {
+		sun_alt_az(site[i].d, site[i].lon, site[i].lat, &alt, &az);
+		sum += alt + az;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_alt_az_series(void)
+{
+	double sum = 0.0;
+	int i;
+
+	/* One minute steps, SITES samples each, count one call per sample */
+	for (i = 0; i < 16; i++) {
+		sun_alt_az_series(site[i].d, 1.0 / 1440.0, SITES, site[i].lon, site[i].lat,
+				  out1, out2);
+		sum += out1[SITES - 1] + out2[SITES - 1];
+	}
+	sink = sum;
+
+	return 16 * SITES;
+}
+
+static long run_GMST0(void)
+{
+	double sum = 0.0;
+	int i;
+
+	for (i = 0; i < SITES; i++)
+		sum += GMST0(site[i].d);
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_batch(void)
+{
+	/* All sites on the date of the first one, that is the use case */
+	sunriset_batch(site[0].year, site[0].month, site[0].day, lons, lats, SITES,
+		       -35.0 / 60.0, 1, out1, out2, rcs);
+	sink = out1[SITES - 1];
+
+	return SITES;
+}
+
+static long run_ephemeris(void)
+{
+	struct sunriset_ephemeris e;
+	double rise, set, sum = 0.0;
+	int i;
+
+	/* As run_batch(), including the cost of the ephemeris */
+	sunriset_ephemeris_init(&e, site[0].year, site[0].month, site[0].day);
+	for (i = 0; i < SITES; i++) {
+		sunriset_ephemeris_eval(&e, lons[i], lats[i], -35.0 / 60.0, 1, &rise, &set);
+		sum += rise + set;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static long run_events(void)
+{
+	struct sunriset_event ev[] = {
+		{ .altit = -35.0 / 60.0, .upper_limb = 1 },
+		{ .altit =  -6.0 },
+		{ .altit = -12.0 },
+		{ .altit = -18.0 },
+	};
+	double sum = 0.0;
+	int i;
+
+	/* One call covers four altitudes, count it as four events */
+	for (i = 0; i < SITES; i++) {
+		sunriset_events(site[i].year, site[i].month, site[i].day, site[i].lon,
+				site[i].lat, ev, NELEMS(ev));
+		sum += ev[0].rise + ev[3].set;
+	}
+	sink = sum;
+
+	return SITES * NELEMS(ev);
+}
+
+static long run_range(void)
+{
+	struct sunriset_event ev = { .altit = -35.0 / 60.0, .upper_limb = 1 };
+	struct sunriset_range r;
+	double sum = 0.0;
+	int i;
+
+	sunriset_range_init(&r, site[0].year, site[0].month, site[0].day, site[0].lon, site[0].lat);
+	for (i = 0; i < SITES; i++) {
+		sunriset_range_next(&r, &ev, 1);
+		sum += ev.rise + ev.set;
+	}
+	sink = sum;
+
+	return SITES;
+}
+
+static struct test {
+	const char *name;
+	long      (*fn)(void);
+} tests[] = {
+	{ "__sunriset__",        run_sunriset },
+	{ "__sunriset_at__",     run_sunriset_at },
+	{ "sunriset_refined",    run_refined  },
+	{ "__sunriset_precise__", run_precise },
+	{ "__daylen__",          run_daylen   },
+	{ "__daylen_at__",       run_daylen_at },
+	{ "sunpos",              run_sunpos   },
+	{ "sun_RA_dec",          run_RA_dec   },
+	{ "sun_position_precise", run_position },
+	{ "sun_alt_az",          run_alt_az   },
+	{ "sun_alt_az_series",   run_alt_az_series },
+	{ "GMST0",               run_GMST0    },
+	{ "sunriset_batch",      run_batch    },
+	{ "sunriset_ephemeris_eval", run_ephemeris },
+	{ "sunriset_events",     run_events   },
+	{ "sunriset_range_next", run_range    },
+};
+
+static void measure(struct test *t, const char *backend, struct band *b, struct span *s)
+{
+	unsigned long long c0, c1;
+	double t0, t1, ns;
+	long calls = 0;
+
+	t->fn();		/* Warm up */
+
+	t0 = now();
+	c0 = ticks();
+	do
+		calls += t->fn();
+	while ((t1 = now()) - t0 < mintime);
+	c1 = ticks();
+
+	ns = (t1 - t0) * 1e9 / calls;
+	printf("{ \"version\": \"%s\", \"bench\": \"%s\", \"backend\": \"%s\", "
+	       "\"latitude\": \"%s\", \"dates\": \"%s\", \"calls\": %ld, "
+	       "\"ns_per_call\": %.2f, \"calls_per_sec\": %.0f, ",
+	       PACKAGE_VERSION, t->name, backend, b->name, s->name, calls, ns, 1e9 / ns);
+	if (c1 > c0)
+		printf("\"cycles_per_call\": %.1f }\n", (double)(c1 - c0) / calls);
+	else
+		printf("\"cycles_per_call\": null }\n");
+	fflush(stdout);
+}
+
+static int usage(int code)
+{
+	printf("Usage: sunbench [-h] [-t SEC] [NAME]\n"
+	       "\n"
+	       "  -h      This help text\n"
+	       "  -t SEC  Minimum time per measurement, default 0.2\n"
+	       "  NAME    Only run benchmarks whose name contains NAME\n");
+
+	return code;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *ephemeris[] = { "kepler", "chebyshev" };
+	char *filter = NULL;
+	size_t i, j, k, e;
+	int c;
+
+	while ((c = getopt(argc, argv, "ht:")) != EOF) {
+		switch (c) {
+		case 't':
+			mintime = atof(optarg);
+			break;
+
+		case 'h':
+			return usage(0);
+
+		default:
+			return usage(1);
+		}
+	}
+	if (optind < argc)
+		filter = argv[optind];
+
+	for (e = 0; e < NELEMS(ephemeris); e++) {
+		char backend[32];
+
+		if (sunriset_backend(e == 0 ? SUNRISET_KEPLER : SUNRISET_CHEBYSHEV) < 0)
+			continue;
+		snprintf(backend, sizeof(backend), "%s+%s", ephemeris[e], TRIG);
+
+		for (i = 0; i < NELEMS(tests); i++) {
+			if (filter && !strstr(tests[i].name, filter))
+				continue;
+
+			for (j = 0; j < NELEMS(bands); j++) {
+				for (k = 0; k < NELEMS(spans); k++) {
+					srand(j * 100 + k);
+					setup(&bands[j], &spans[k]);
+					measure(&tests[i], backend, &bands[j], &spans[k]);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,264 @@
+/*
+
+Persistent cache of computed SUNRISET events
+
+One file per location, named after the latitude and longitude quantised
+to 1/100 degree, and the ephemeris backend and trig functions in use,
+since their times differ a little.  The file is a small header followed
+by one fixed-size record per day, from 2000-01-01 to 2099-12-31, and is
+memory-mapped so a lookup is just an index into the map.  Records are
+filled lazily, the file is created sparse so only days actually used
+take disk space.  The header holds SUNRISET_ALGORITHM; on mismatch a
+new file is built under a temporary name and renamed into place.  Other
+processes may have the old one mapped, without any lock, and keep it
+until they close their cache.
+
+Released to the public domain
+
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sunriset.h"
+
+#define CACHE_MAGIC   "SUNCACHE"
+#define CACHE_VALID   0x5a5a5a5a
+#define CACHE_FIRST   days_since_2000_Jan_0(2000, 1, 1)
+#define CACHE_DAYS    (days_since_2000_Jan_0(2100, 1, 1) - CACHE_FIRST)
+
+struct cache_hdr {
+	char     magic[8];	/* CACHE_MAGIC */
+	uint32_t version;	/* SUNRISET_ALGORITHM */
+	uint32_t size;		/* sizeof(struct cache_rec) */
+	int32_t  lat, lon;	/* Quantised location, 1/100 degrees */
+	int32_t  first;		/* Day number of first record */
+	uint32_t count;		/* Number of records */
+};
+
+struct cache_rec {
+	uint32_t valid;		/* CACHE_VALID when filled in */
+	int8_t   rc[SUNRISET_CACHE_EVENTS];
+	float    rise[SUNRISET_CACHE_EVENTS];
+	float    set[SUNRISET_CACHE_EVENTS];
+};
+
+struct sunriset_cache {
+	double            lat, lon;
+	int               writable;
+	size_t            len;
+	struct cache_hdr *hdr;
+	struct cache_rec *rec;
+};
+
+static const struct {
+	double altit;
+	int    upper_limb;
+} altitude[SUNRISET_CACHE_EVENTS] = {
+	{ -35.0 / 60.0, 1 },	/* Rise/set */
+	{  -6.0,        0 },	/* Civil twilight */
+	{ -12.0,        0 },	/* Nautical twilight */
+	{ -18.0,        0 },	/* Astronomical twilight */
+};
+
+static int quantise(double deg)
+{
+	return (int)(deg * 100.0 + (deg < 0 ? -0.5 : 0.5));
+}
+
+static int valid(struct cache_hdr *hdr, int lat, int lon)
+{
+	return !memcmp(hdr->magic, CACHE_MAGIC, sizeof(hdr->magic)) &&
+		hdr->version == SUNRISET_ALGORITHM &&
+		hdr->size    == sizeof(struct cache_rec) &&
+		hdr->lat == lat && hdr->lon == lon &&
+		hdr->first   == CACHE_FIRST &&
+		hdr->count   == CACHE_DAYS;
+}
+
+/* Build variant, the times of each differ a little from the others */
+static const char *variant(void)
+{
+#ifdef SUNRISET_FAST_MATH
+	return sunriset_backend(-1) == SUNRISET_CHEBYSHEV ? ".cheb.fast" : ".fast";
+#else
+	return sunriset_backend(-1) == SUNRISET_CHEBYSHEV ? ".cheb" : "";
+#endif
+}
+
+/*
+ * Create a new, empty, file in place of path, called with an exclusive
+ * lock held on the old one
+ */
+static int reset(const char *path, size_t len, int lat, int lon)
+{
+	struct cache_hdr hdr;
+	char tmp[512];
+	int fd;
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic));
+	hdr.version = SUNRISET_ALGORITHM;
+	hdr.size    = sizeof(struct cache_rec);
+	hdr.lat     = lat;
+	hdr.lon     = lon;
+	hdr.first   = CACHE_FIRST;
+	hdr.count   = CACHE_DAYS;
+
+	snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path);
+	fd = mkstemp(tmp);
+	if (fd < 0)
+		return -1;
+
+	if (fchmod(fd, 0644) || ftruncate(fd, len) ||
+	    pwrite(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) || rename(tmp, path)) {
+		unlink(tmp);
+		close(fd);
+		return -1;
+	}
+
+	return close(fd);
+}
+
+/* Whether fd is still the file at path, and not one renamed over it */
+static int current(int fd, const char *path)
+{
+	struct stat a, b;
+
+	if (fstat(fd, &a) || stat(path, &b))
+		return 0;
+
+	return a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+}
+
+sunriset_cache *sunriset_cache_open(const char *dir, double lon, double lat)
+{
+	struct sunriset_cache *c;
+	struct cache_hdr hdr;
+	char path[500];
+	int fd, qlat, qlon, prot, tries = 0;
+	size_t len;
+
+	qlat = quantise(lat);
+	qlon = quantise(lon);
+	len  = sizeof(struct cache_hdr) + CACHE_DAYS * sizeof(struct cache_rec);
+
+	mkdir(dir, 0755);
+	snprintf(path, sizeof(path), "%s/%+06d%+07d%s", dir, qlat, qlon, variant());
+retry:
+	prot = PROT_READ | PROT_WRITE;
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		fd = open(path, O_RDONLY);
+		if (fd < 0)
+			return NULL;
+		prot = PROT_READ;
+	}
+
+	/*
+	 * Check header, only take the lock if it needs (re)initializing.
+	 * Whoever holds it may have replaced the file meanwhile, then the
+	 * new one is opened instead.
+	 */
+	if (pread(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) || !valid(&hdr, qlat, qlon)) {
+		if (!(prot & PROT_WRITE) || tries++ > 2 || flock(fd, LOCK_EX))
+			goto fail;
+		if (!current(fd, path)) {
+			close(fd);
+			goto retry;
+		}
+		if (pread(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) || !valid(&hdr, qlat, qlon)) {
+			if (reset(path, len, qlat, qlon))
+				goto fail;
+			close(fd);
+			goto retry;
+		}
+		flock(fd, LOCK_UN);
+	}
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		goto fail;
+
+	c->hdr = mmap(NULL, len, prot, MAP_SHARED, fd, 0);
+	close(fd);
+	if (c->hdr == MAP_FAILED) {
+		free(c);
+		return NULL;
+	}
+
+	c->lat      = qlat / 100.0;
+	c->lon      = qlon / 100.0;
+	c->writable = prot & PROT_WRITE;
+	c->len      = len;
+	c->rec      = (struct cache_rec *)(c->hdr + 1);
+
+	return c;
+fail:
+	close(fd);
+	return NULL;
+}
+
+int sunriset_cache_get(sunriset_cache *c, int year, int month, int day,
+		       struct sunriset_event ev[SUNRISET_CACHE_EVENTS])
+{
+	struct cache_rec *rec = NULL;
+	long i;
+
+	for (i = 0; i < SUNRISET_CACHE_EVENTS; i++) {
+		ev[i].altit      = altitude[i].altit;
+		ev[i].upper_limb = altitude[i].upper_limb;
+	}
+
+	i = days_since_2000_Jan_0(year, month, day) - CACHE_FIRST;
+	if (i >= 0 && i < CACHE_DAYS)
+		rec = &c->rec[i];
+
+	if (rec && __atomic_load_n(&rec->valid, __ATOMIC_ACQUIRE) == CACHE_VALID) {
+		for (i = 0; i < SUNRISET_CACHE_EVENTS; i++) {
+			ev[i].rise   = rec->rise[i];
+			ev[i].set    = rec->set[i];
+			ev[i].daylen = ev[i].set - ev[i].rise;
+			ev[i].rc     = rec->rc[i];
+		}
+
+		return 1;
+	}
+
+	sunriset_events(year, month, day, c->lon, c->lat, ev, SUNRISET_CACHE_EVENTS);
+	if (!rec || !c->writable)
+		return 0;
+
+	/* Concurrent writers store the same values, publish valid last */
+	for (i = 0; i < SUNRISET_CACHE_EVENTS; i++) {
+		rec->rise[i] = ev[i].rise;
+		rec->set[i]  = ev[i].set;
+		rec->rc[i]   = ev[i].rc;
+	}
+	__atomic_store_n(&rec->valid, CACHE_VALID, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+void sunriset_cache_close(sunriset_cache *c)
+{
+	if (!c)
+		return;
+
+	munmap(c->hdr, c->len);
+	free(c);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,40 @@
+/*
+
+Chebyshev ephemeris backend for SUNRISET
+
+Instead of the Kepler approximation in sunpos() and sun_RA_dec(), look
+up the segment for d in a table generated by chebgen and evaluate three
+short Chebyshev series.  Enable with --enable-chebyshev, then select at
+runtime with sunriset_backend().  Run `chebgen -r` for the accuracy
+report against the Kepler code.
+
+Released to the public domain
+
+ */
+#include "cheb.h"
+#include "chebdata.h"
+
+int cheb_RA_dec(double d, double *RA, double *dec, double *r)
+{
+	const double (*c)[CHEB_ORDER];
+	double x;
+	int i;
+
+	i = cheb_segment(d, &x);
+	if (i < 0)
+		return 0;
+
+	c    = chebdata[i];
+	*dec = cheb_eval(c[CHEB_DEC], x);
+	*RA  = rev180(GMST0(d) - 180.0 + cheb_eval(c[CHEB_RA], x));
+	*r   = cheb_eval(c[CHEB_R], x);
+
+	return 1;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,72 @@
+/*
+
+Chebyshev ephemeris backend for SUNRISET, shared by cheb.c and chebgen.c
+
+Released to the public domain
+
+ */
+#ifndef SUNRISET_CHEB_H_
+#define SUNRISET_CHEB_H_
+
+#include "sunriset.h"
+
+/*
+ * The Sun's declination, RA - GMST0 + 180 (i.e., minus the equation of
+ * time) and radius vector are stored as Chebyshev series, CHEB_ORDER
+ * coefficients per quantity for each CHEB_DAYS day segment.  The table
+ * covers 1801-2099, plus a day of margin at each end for the longitude
+ * shift of d in __sunriset__.
+ */
+#define CHEB_DAYS      32
+#define CHEB_ORDER     8
+#define CHEB_FIRST     (days_since_2000_Jan_0(1801, 1, 1) - 1)
+#define CHEB_LAST      (days_since_2000_Jan_0(2100, 1, 1) + 1)
+#define CHEB_SEGMENTS  ((CHEB_LAST - CHEB_FIRST) / CHEB_DAYS + 1)
+
+enum { CHEB_DEC, CHEB_RA, CHEB_R, CHEB_NUM };
+
+/*
+ * Clenshaw's recurrence, -1 <= x <= 1
+ */
+static inline double cheb_eval(const double *c, double x)
+{
+	double b1 = 0.0, b2 = 0.0, x2 = 2.0 * x;
+	int j;
+
+	for (j = CHEB_ORDER - 1; j > 0; j--) {
+		double b = x2 * b1 - b2 + c[j];
+
+		b2 = b1;
+		b1 = b;
+	}
+
+	return x * b1 - b2 + c[0];
+}
+
+/*
+ * Segment index and normalized x for d, returns -1 if out of range.
+ */
+static inline int cheb_segment(double d, double *x)
+{
+	double t = d - CHEB_FIRST;
+	int i;
+
+	if (t < 0.0 || t >= (double)CHEB_SEGMENTS * CHEB_DAYS)
+		return -1;
+
+	i  = (int)(t / CHEB_DAYS);
+	*x = 2.0 * (t - (double)i * CHEB_DAYS) / CHEB_DAYS - 1.0;
+
+	return i;
+}
+
+int cheb_RA_dec(double d, double *RA, double *dec, double *r);
+
+#endif /* SUNRISET_CHEB_H_ */
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
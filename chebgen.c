@@ -0,0 +1,192 @@
+/*
+
+Generate the Chebyshev ephemeris table for SUNRISET
+
+Fits the Sun's declination, RA - GMST0 + 180 and radius vector, as
+computed by sun_RA_dec(), with Chebyshev series on each segment, see
+cheb.h.  Called at build time to create chebdata.h, or with -r to print
+an accuracy report of the fitted series against sun_RA_dec() and
+__sunriset__.
+
+Released to the public domain
+
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "cheb.h"
+
+static double (*table)[CHEB_NUM][CHEB_ORDER];
+
+static void quantities(double d, double q[CHEB_NUM])
+{
+	double RA, dec, r;
+
+	sun_RA_dec(d, &RA, &dec, &r);
+	q[CHEB_DEC] = dec;
+	q[CHEB_RA]  = rev180(RA - GMST0(d) + 180.0);
+	q[CHEB_R]   = r;
+}
+
+/*
+ * Chebyshev interpolation at the CHEB_ORDER zeros of T_n
+ */
+static void fit(int seg)
+{
+	double f[CHEB_ORDER][CHEB_NUM], mid, half;
+	int j, k, n;
+
+	half = CHEB_DAYS / 2.0;
+	mid  = CHEB_FIRST + (double)seg * CHEB_DAYS + half;
+	for (k = 0; k < CHEB_ORDER; k++)
+		quantities(mid + half * cos(PI * (k + 0.5) / CHEB_ORDER), f[k]);
+
+	for (n = 0; n < CHEB_NUM; n++) {
+		for (j = 0; j < CHEB_ORDER; j++) {
+			double sum = 0.0;
+
+			for (k = 0; k < CHEB_ORDER; k++)
+				sum += f[k][n] * cos(PI * j * (k + 0.5) / CHEB_ORDER);
+			table[seg][n][j] = 2.0 * sum / CHEB_ORDER;
+		}
+		table[seg][n][0] /= 2.0;
+	}
+}
+
+static void generate(void)
+{
+	int i, n, j;
+
+	printf("/* This is a generated file, see chebgen.c to update it */\n\n");
+	printf("static const double chebdata[%ld][%d][%d] = {\n", (long)CHEB_SEGMENTS, CHEB_NUM, CHEB_ORDER);
+	for (i = 0; i < CHEB_SEGMENTS; i++) {
+		printf("\t{ /* d = %ld */\n", (long)CHEB_FIRST + (long)i * CHEB_DAYS);
+		for (n = 0; n < CHEB_NUM; n++) {
+			printf("\t\t{ ");
+			for (j = 0; j < CHEB_ORDER; j++)
+				printf("%.17g%s", table[i][n][j], j + 1 < CHEB_ORDER ? ", " : " ");
+			printf("},\n");
+		}
+		printf("\t},\n");
+	}
+	printf("};\n");
+}
+
+/*
+ * Rise and set from the fitted series, same as __sunriset__
+ */
+static int riset(int year, int month, int day, double lon, double lat, double *rise, double *set)
+{
+	double d, x, dec, RA, r, tsouth, altit, cost, t;
+	int i;
+
+	d = days_since_2000_Jan_0(year, month, day) + 0.5 - lon / 360.0;
+	i = cheb_segment(d, &x);
+	if (i < 0)
+		return 1;
+
+	dec = cheb_eval(table[i][CHEB_DEC], x);
+	RA  = GMST0(d) - 180.0 + cheb_eval(table[i][CHEB_RA], x);
+	r   = cheb_eval(table[i][CHEB_R], x);
+
+	tsouth = 12.0 - rev180(revolution(GMST0(d) + 180.0 + lon) - RA) / 15.0;
+	altit  = -35.0 / 60.0 - 0.2666 / r;
+	cost   = (sind(altit) - sind(lat) * sind(dec)) / (cosd(lat) * cosd(dec));
+	if (cost >= 1.0 || cost <= -1.0)
+		return 1;
+
+	t = acosd(cost) / 15.0;
+	*rise = tsouth - t;
+	*set  = tsouth + t;
+
+	return 0;
+}
+
+static void report(void)
+{
+	double lat[] = { 0.0, 30.0, 50.0, 60.0, 65.0, -45.0 };
+	double err[CHEB_NUM] = { 0.0 }, ev = 0.0;
+	int i, k, n, y, m, dd;
+
+	for (i = 0; i < CHEB_SEGMENTS; i++) {
+		double mid = CHEB_FIRST + (i + 0.5) * CHEB_DAYS;
+
+		for (k = 0; k <= 64; k++) {
+			double x = k / 32.0 - 1.0, q[CHEB_NUM];
+
+			quantities(mid + x * CHEB_DAYS / 2.0, q);
+			for (n = 0; n < CHEB_NUM; n++) {
+				double e = fabs(cheb_eval(table[i][n], x) - q[n]);
+
+				if (e > err[n])
+					err[n] = e;
+			}
+		}
+	}
+
+	for (y = 1901; y < 2100; y++) {
+		for (m = 1; m <= 12; m++) {
+			for (dd = 1; dd <= 28; dd += 3) {
+				for (k = 0; k < (int)(sizeof(lat) / sizeof(lat[0])); k++) {
+					double lon = 15.0 * k - 40.0, r1, s1, r2, s2;
+
+					if (__sunriset__(y, m, dd, lon, lat[k], -35.0 / 60.0, 1, &r1, &s1))
+						continue;
+					if (riset(y, m, dd, lon, lat[k], &r2, &s2))
+						continue;
+					if (fabs(r1 - r2) > ev)
+						ev = fabs(r1 - r2);
+					if (fabs(s1 - s2) > ev)
+						ev = fabs(s1 - s2);
+				}
+			}
+		}
+	}
+
+	printf("Chebyshev backend, %d days x %d coefficients, %ld segments, %ld bytes\n",
+	       CHEB_DAYS, CHEB_ORDER, (long)CHEB_SEGMENTS, (long)sizeof(double) * CHEB_SEGMENTS * CHEB_NUM * CHEB_ORDER);
+	printf("Max error declination     %.3g arcsec\n", err[CHEB_DEC] * 3600.0);
+	printf("Max error RA - GMST0      %.3g arcsec\n", err[CHEB_RA] * 3600.0);
+	printf("Max error radius vector   %.3g AU\n", err[CHEB_R]);
+	printf("Max error rise/set        %.3g seconds (1901-2099)\n", ev * 3600.0);
+}
+
+int main(int argc, char *argv[])
+{
+	int c, i, rep = 0;
+
+	while ((c = getopt(argc, argv, "hr")) != EOF) {
+		switch (c) {
+		case 'r':
+			rep = 1;
+			break;
+
+		default:
+			fprintf(stderr, "Usage: chebgen [-r] > chebdata.h\n");
+			return c == 'h' ? 0 : 1;
+		}
+	}
+
+	table = calloc(CHEB_SEGMENTS, sizeof(*table));
+	if (!table)
+		return 1;
+
+	for (i = 0; i < CHEB_SEGMENTS; i++)
+		fit(i);
+
+	if (rep)
+		report();
+	else
+		generate();
+
+	return 0;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
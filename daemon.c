@@ -0,0 +1,483 @@
+/*
+
+Rule based event daemon for the SUNRISET front-end application
+
+Instead of one cron job per automation, each running `sun -w` and then a
+command, a single `sun --daemon=FILE` process reads a list of rules:
+
+	# EVENT [OFFSET] run COMMAND
+	sunset -30m run /usr/local/bin/lights on
+	civil dusk  run logger "civil dusk"
+	sunrise     run /usr/local/bin/lights off
+
+Events are sunrise, sunset, noon, and civil, nautical or astronomical
+dawn and dusk.  The offset is given as in `sun -o`, e.g. -30m, +1h or
+90s.  Commands are run with /bin/sh -c, with SUN_EVENT set to the name
+of the event.
+
+The day's events are computed once, at start and then at each local
+midnight, and the pending hooks are kept in a min-heap by time.  The
+daemon sleeps in sigtimedwait() until the first of them is due, so
+there is one wakeup per event.  SIGHUP reloads the rules, SIGTERM and
+SIGINT exit.
+
+Released to the public domain
+
+ */
+#include "config.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#include "daemon.h"
+#include "sunriset.h"
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+
+extern char **environ;
+
+/* Index into the sunriset_events() array, and which end of it */
+enum { RISE, SET, SOUTH };
+
+static const struct {
+	const char *name;
+	int         ev;
+	int         which;
+} events[] = {
+	{ "sunrise",           0, RISE  },
+	{ "sunset",            0, SET   },
+	{ "noon",              0, SOUTH },
+	{ "civil-dawn",        1, RISE  },
+	{ "civil-dusk",        1, SET   },
+	{ "nautical-dawn",     2, RISE  },
+	{ "nautical-dusk",     2, SET   },
+	{ "astronomical-dawn", 3, RISE  },
+	{ "astronomical-dusk", 3, SET   },
+};
+
+struct rule {
+	int    event;		/* Index into events[] */
+	long   offset;		/* Seconds, relative to event */
+	char  *cmd;
+};
+
+struct hook {
+	time_t when;
+	int    rule;
+};
+
+static struct rule *rules;
+static size_t       nrules;
+
+static struct hook *heap;
+static size_t       nheap;
+
+static int verbose;
+
+#define LOG(fmt, args...) if (verbose > 0) printf(fmt, ##args)
+
+/*
+ * Min-heap of pending hooks, ordered by time
+ */
+static void heap_push(time_t when, int rule)
+{
+	size_t i = nheap++;
+
+	while (i > 0) {
+		size_t parent = (i - 1) / 2;
+
+		if (heap[parent].when <= when)
+			break;
+		heap[i] = heap[parent];
+		i = parent;
+	}
+	heap[i].when = when;
+	heap[i].rule = rule;
+}
+
+static struct hook heap_pop(void)
+{
+	struct hook top = heap[0], last = heap[--nheap];
+	size_t i = 0;
+
+	while (1) {
+		size_t child = 2 * i + 1;
+
+		if (child >= nheap)
+			break;
+		if (child + 1 < nheap && heap[child + 1].when < heap[child].when)
+			child++;
+		if (last.when <= heap[child].when)
+			break;
+		heap[i] = heap[child];
+		i = child;
+	}
+	if (nheap)
+		heap[i] = last;
+
+	return top;
+}
+
+static long parse_offset(const char *arg, int *ok)
+{
+	long val;
+	char *end;
+
+	val = strtol(arg, &end, 10);
+	switch (*end) {
+	case 'h':
+	case 'H':
+		val *= 3600;
+		end++;
+		break;
+
+	case 'm':
+	case 'M':
+		val *= 60;
+		end++;
+		break;
+
+	case 's':
+	case 'S':
+		end++;
+		break;
+	}
+
+	*ok = end != arg && *end == 0;
+
+	return val;
+}
+
+static int parse_event(const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < NELEMS(events); i++) {
+		if (!strcmp(events[i].name, name))
+			return i;
+	}
+
+	return -1;
+}
+
+/*
+ * Parse one line: EVENT [OFFSET] run COMMAND, where EVENT may be given
+ * as one or two words, e.g. "civil dusk" or "civil-dusk"
+ */
+static int parse_rule(char *line, struct rule *r)
+{
+	char name[32] = "", *tok, *run = NULL;
+	int ok = 1;
+
+	r->offset = 0;
+	for (tok = strtok(line, " \t"); tok; tok = strtok(NULL, " \t")) {
+		/* The command is the rest of the line, spaces and all */
+		if (!strcmp(tok, "run")) {
+			run = strtok(NULL, "");
+			break;
+		}
+
+		if (*tok == '+' || *tok == '-' || isdigit((unsigned char)*tok)) {
+			r->offset = parse_offset(tok, &ok);
+			if (!ok)
+				return 0;
+			continue;
+		}
+
+		if (name[0])
+			strncat(name, "-", sizeof(name) - strlen(name) - 1);
+		strncat(name, tok, sizeof(name) - strlen(name) - 1);
+	}
+
+	if (!run)
+		return 0;
+	while (isspace((unsigned char)*run))
+		run++;
+	if (!*run)
+		return 0;
+
+	r->event = parse_event(name);
+	if (r->event < 0)
+		return 0;
+
+	r->cmd = strdup(run);
+	if (!r->cmd)
+		return 0;
+
+	return 1;
+}
+
+static void rules_free(struct rule *list, size_t num)
+{
+	size_t i;
+
+	for (i = 0; i < num; i++)
+		free(list[i].cmd);
+	free(list);
+}
+
+/*
+ * Load rules from file, on error the current rules are kept
+ */
+static int load(const char *file)
+{
+	struct rule *list = NULL;
+	struct hook *tmp;
+	size_t num = 0, lineno = 0;
+	char buf[512];
+	FILE *fp;
+
+	fp = fopen(file, "r");
+	if (!fp) {
+		fprintf(stderr, "Cannot open %s: %s\n", file, strerror(errno));
+		return 0;
+	}
+
+	while (fgets(buf, sizeof(buf), fp)) {
+		struct rule r, *next;
+		char *ptr = buf;
+
+		lineno++;
+		buf[strcspn(buf, "\r\n")] = 0;
+		while (isspace((unsigned char)*ptr))
+			ptr++;
+		if (!*ptr || *ptr == '#')
+			continue;
+
+		if (!parse_rule(ptr, &r)) {
+			fprintf(stderr, "%s:%zu: invalid rule\n", file, lineno);
+			rules_free(list, num);
+			fclose(fp);
+			return 0;
+		}
+
+		next = realloc(list, (num + 1) * sizeof(*list));
+		if (!next) {
+			free(r.cmd);
+			rules_free(list, num);
+			fclose(fp);
+			return 0;
+		}
+		list = next;
+		list[num++] = r;
+	}
+	fclose(fp);
+
+	/* Room for three days of hooks, see schedule() */
+	tmp = realloc(heap, (3 * num + 1) * sizeof(*heap));
+	if (!tmp) {
+		rules_free(list, num);
+		return 0;
+	}
+	heap = tmp;
+
+	rules_free(rules, nrules);
+	rules  = list;
+	nrules = num;
+	LOG("Loaded %zu rules from %s\n", nrules, file);
+
+	return 1;
+}
+
+/*
+ * Compute the events of one date and queue the hooks still ahead
+ */
+static void queue(int year, int month, int day, time_t now, double lat, double lon)
+{
+	struct sunriset_event ev[] = {
+		{ .altit = -35.0 / 60.0, .upper_limb = 1 },
+		{ .altit =  -6.0 },
+		{ .altit = -12.0 },
+		{ .altit = -18.0 },
+	};
+	struct tm date;
+	time_t midnight;
+	size_t i;
+
+	sunriset_events(year, month, day, lon, lat, ev, NELEMS(ev));
+
+	/* Keep each date's events on its own day, also near the date line */
+	for (i = 0; i < NELEMS(ev); i++)
+		sunriset_unwrap(lon, &ev[i].rise, &ev[i].set);
+
+	/* Event times are in hours UT from 0h UT of the date */
+	memset(&date, 0, sizeof(date));
+	date.tm_year = year - 1900;
+	date.tm_mon  = month - 1;
+	date.tm_mday = day;
+	midnight = timegm(&date);
+
+	for (i = 0; i < nrules; i++) {
+		struct sunriset_event *e = &ev[events[rules[i].event].ev];
+		double ut;
+		time_t when;
+
+		switch (events[rules[i].event].which) {
+		case RISE:
+			if (e->rc)
+				continue;
+			ut = e->rise;
+			break;
+
+		case SET:
+			if (e->rc)
+				continue;
+			ut = e->set;
+			break;
+
+		default:
+			ut = (e->rise + e->set) / 2.0;
+			break;
+		}
+
+		when = midnight + (time_t)(ut * 3600.0 + 0.5) + rules[i].offset;
+		if (when <= now)
+			continue;
+
+		heap_push(when, i);
+	}
+}
+
+/*
+ * Queue the hooks of the local date of now, those of the day before
+ * that fall after midnight, e.g. "sunset +6h", and those of the day
+ * after that fall before the next one, e.g. "sunrise -6h".  Returns
+ * next midnight.
+ */
+static time_t schedule(time_t now, double lat, double lon)
+{
+	struct tm date, day;
+	int i;
+
+	localtime_r(&now, &date);
+
+	nheap = 0;
+	for (i = -1; i <= 1; i++) {
+		day = date;
+		day.tm_mday += i;
+		day.tm_hour  = 12;
+		day.tm_isdst = -1;
+		mktime(&day);
+		queue(1900 + day.tm_year, 1 + day.tm_mon, day.tm_mday, now, lat, lon);
+	}
+
+	/* Next local midnight, mktime() takes care of DST and month ends */
+	day = date;
+	day.tm_mday++;
+	day.tm_hour  = 0;
+	day.tm_min   = 0;
+	day.tm_sec   = 0;
+	day.tm_isdst = -1;
+
+	return mktime(&day);
+}
+
+static void run(struct rule *r, const sigset_t *mask)
+{
+	char *argv[] = { "sh", "-c", r->cmd, NULL };
+	char var[64], **env;
+	posix_spawnattr_t attr;
+	size_t i, n;
+	pid_t pid;
+	int rc;
+
+	/* Environment of the daemon, plus SUN_EVENT */
+	for (n = 0; environ[n]; n++)
+		;
+	env = calloc(n + 2, sizeof(char *));
+	if (!env)
+		return;
+	snprintf(var, sizeof(var), "SUN_EVENT=%s", events[r->event].name);
+	env[0] = var;
+	for (i = 0; i < n; i++)
+		env[i + 1] = environ[i];
+
+	/* Children should not inherit the blocked signals */
+	posix_spawnattr_init(&attr);
+	posix_spawnattr_setsigmask(&attr, mask);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+	LOG("%s: %s\n", events[r->event].name, r->cmd);
+	rc = posix_spawn(&pid, "/bin/sh", NULL, &attr, argv, env);
+	if (rc)
+		fprintf(stderr, "Failed starting %s: %s\n", r->cmd, strerror(rc));
+
+	posix_spawnattr_destroy(&attr);
+	free(env);
+}
+
+int daemon_run(const char *file, double lat, double lon, int level)
+{
+	sigset_t set, old;
+	time_t midnight;
+
+	verbose = level;
+	if (!load(file))
+		return 1;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGHUP);
+	sigaddset(&set, SIGTERM);
+	sigaddset(&set, SIGINT);
+	sigaddset(&set, SIGCHLD);
+	sigprocmask(SIG_BLOCK, &set, &old);
+
+	midnight = schedule(time(NULL), lat, lon);
+	while (1) {
+		struct timespec timeout = { 0, 0 };
+		time_t now, next;
+		int sig;
+
+		now  = time(NULL);
+		next = nheap && heap[0].when < midnight ? heap[0].when : midnight;
+		if (next > now)
+			timeout.tv_sec = next - now;
+
+		sig = sigtimedwait(&set, NULL, &timeout);
+		switch (sig) {
+		case SIGCHLD:
+			while (waitpid(-1, NULL, WNOHANG) > 0)
+				;
+			continue;
+
+		case SIGHUP:
+			LOG("Reloading %s\n", file);
+			load(file);
+			midnight = schedule(time(NULL), lat, lon);
+			continue;
+
+		case SIGTERM:
+		case SIGINT:
+			rules_free(rules, nrules);
+			free(heap);
+			return 0;
+
+		default:	/* Timeout or EINTR */
+			break;
+		}
+
+		now = time(NULL);
+		while (nheap && heap[0].when <= now) {
+			struct hook h = heap_pop();
+
+			run(&rules[h.rule], &old);
+		}
+
+		if (now >= midnight)
+			midnight = schedule(now, lat, lon);
+	}
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
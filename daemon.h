@@ -0,0 +1,20 @@
+/*
+
+Rule based event daemon for the SUNRISET front-end application
+
+Released to the public domain
+
+ */
+#ifndef SUN_DAEMON_H_
+#define SUN_DAEMON_H_
+
+int daemon_run(const char *file, double lat, double lon, int verbose);
+
+#endif /* SUN_DAEMON_H_ */
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,252 @@
+/*
+
+Check of the events near the date line against an altitude scan
+
+There local noon is close to 0h or 24h UT, and once a year the time of
+south of __sunriset__() crosses over to the other end of the date.  The
+next sunrise and sunset from sunriset_next() are compared, from a
+starting time every few hours over a year, with the crossings of the
+Sun's altitude found by sampling it every minute.  So are the switching
+events of a fleet with one device at each site, over the whole year in
+windows of a quarter.  Each must be within SLACK of the crossing, the
+accuracy of __sunriset__() is a minute or two, so an event of the wrong
+day, or one skipped or repeated, fails.  The earliest and latest rise
+and set of the year from sunriset_extremes() must be those of a scan of
+all its dates.  Build and run with `make check`.
+
+Released to the public domain
+
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "sunriset.h"
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+
+/* Altitude of the Sun's center at sunrise and sunset */
+#define HORIZON  (-35.0 / 60.0 - 0.2666)
+
+/* Allowed difference from the crossing, seconds */
+#define SLACK    300
+
+/* Sampled span, and most crossings in it */
+#define YEAR     1735689600	/* 2025-01-01 */
+#define DAYS     368
+#define CHUNK    1440
+#define MAX      (2 * DAYS)
+
+struct site {
+	const char *name;
+	double      lon, lat;
+} sites[] = {
+	{ "Suva",   178.44, -18.14 },
+	{ "Apia",  -171.76, -13.83 },
+	{ "Adak",  -176.66,  51.88 },
+	{ "east",   179.99,  10.00 },
+	{ "west",  -179.99, -10.00 },
+};
+
+struct crossings {
+	time_t t[2][MAX];	/* Sets, then rises */
+	size_t n[2];
+};
+
+/* Minutes where the altitude crosses HORIZON, over DAYS from the day before YEAR */
+static void scan(const struct site *s, struct crossings *c)
+{
+	static time_t t[CHUNK + 1];
+	static double alt[CHUNK + 1], az[CHUNK + 1];
+	time_t start = YEAR - 86400;
+	int day, i;
+
+	c->n[0] = c->n[1] = 0;
+	for (day = 0; day < DAYS; day++) {
+		for (i = 0; i <= CHUNK; i++)
+			t[i] = start + (time_t)day * 86400 + i * 60;
+		sun_alt_az_time(t, CHUNK + 1, s->lon, s->lat, alt, az);
+
+		for (i = 0; i < CHUNK; i++) {
+			int rise = alt[i] < HORIZON && alt[i + 1] >= HORIZON;
+
+			if (!rise && !(alt[i] >= HORIZON && alt[i + 1] < HORIZON))
+				continue;
+			if (c->n[rise] < MAX)
+				c->t[rise][c->n[rise]++] = t[i] + (time_t)(60.0 * (HORIZON - alt[i]) / (alt[i + 1] - alt[i]));
+		}
+	}
+}
+
+/* First crossing after t, or -1 */
+static time_t after(const struct crossings *c, int rise, time_t t)
+{
+	size_t i;
+
+	for (i = 0; i < c->n[rise]; i++) {
+		if (c->t[rise][i] > t)
+			return c->t[rise][i];
+	}
+
+	return -1;
+}
+
+static int next(const struct site *s, const struct crossings *c)
+{
+	long n = 0, fail = 0;
+	time_t t;
+	int rise;
+
+	for (t = YEAR; t < YEAR + 365 * 86400; t += 3 * 3600 + 17 * 60) {
+		for (rise = 0; rise <= 1; rise++) {
+			time_t want = after(c, rise, t), got;
+
+			/* Too close to tell which one is next */
+			if (want < 0 || want - t < SLACK)
+				continue;
+
+			got = sunriset_next(t, s->lon, s->lat, -35.0 / 60.0, 1, rise);
+			n++;
+			if (labs((long)(got - want)) <= SLACK)
+				continue;
+
+			if (!fail++)
+				printf("FAIL: %s next %s after %ld is %ld, should be %ld\n",
+				       s->name, rise ? "rise" : "set", (long)t, (long)got, (long)want);
+		}
+	}
+
+	printf("%-5s %8.2f %6.2f: %ld next events, %ld wrong\n", s->name, s->lon, s->lat, n, fail);
+
+	return fail != 0;
+}
+
+/* Events of a fleet with a device at each site, from start to end */
+static int fleet(const struct crossings *c, time_t start, time_t end)
+{
+	struct sunriset_device dev[NELEMS(sites)];
+	struct sunriset_fleet_event ev;
+	time_t last[NELEMS(sites)][2];
+	sunriset_fleet *f;
+	long n = 0, fail = 0;
+	size_t i;
+	int k;
+
+	for (i = 0; i < NELEMS(sites); i++) {
+		dev[i] = (struct sunriset_device) {
+			.lon = sites[i].lon, .lat = sites[i].lat,
+			.altit = -35.0 / 60.0, .upper_limb = 1,
+		};
+		last[i][0] = last[i][1] = 0;
+	}
+
+	f = sunriset_fleet_open(dev, NELEMS(dev), start, end);
+	if (!f) {
+		printf("FAIL: cannot open fleet\n");
+		return 1;
+	}
+
+	while (sunriset_fleet_next(f, &ev)) {
+		int rise = !ev.on;
+		time_t want = after(&c[ev.device], rise, ev.when - SLACK);
+		time_t *prev = &last[ev.device][rise];
+
+		/* The crossing, and one every day, none skipped or repeated */
+		k = labs((long)(ev.when - want)) <= SLACK;
+		if (!*prev)
+			k = k && ev.when - start < 28 * 3600;
+		else
+			k = k && ev.when - *prev > 20 * 3600 && ev.when - *prev < 28 * 3600;
+		*prev = ev.when;
+		n++;
+		if (k)
+			continue;
+
+		if (!fail++)
+			printf("FAIL: %s %s at %ld, should be %ld\n", sites[ev.device].name,
+			       ev.on ? "on" : "off", (long)ev.when, (long)want);
+	}
+	sunriset_fleet_close(f);
+
+	/* Nothing missing at the end */
+	for (i = 0; i < NELEMS(sites); i++) {
+		for (k = 0; k <= 1; k++) {
+			if (end - last[i][k] < 28 * 3600)
+				continue;
+			if (!fail++)
+				printf("FAIL: %s %s missing after %ld\n", sites[i].name,
+				       k ? "off" : "on", (long)last[i][k]);
+		}
+	}
+
+	printf("fleet %ld..%ld: %ld events, %ld wrong\n", (long)start, (long)end, n, fail);
+
+	return fail != 0;
+}
+
+/* Extremes of the year against every date, with the same unwrapped times */
+static int extremes(const struct site *s)
+{
+	struct sunriset_extremes ex;
+	const struct sunriset_extreme *e[4] = {
+		&ex.earliest_rise, &ex.latest_rise, &ex.earliest_set, &ex.latest_set,
+	};
+	double best[4] = { 1e9, -1e9, 1e9, -1e9 };
+	int month, day, fail = 0, i;
+
+	sunriset_extremes(2025, s->lon, s->lat, -35.0 / 60.0, 1, &ex);
+
+	for (month = 1; month <= 12; month++) {
+		for (day = 1; day <= 31; day++) {
+			double rise, set;
+
+			if (__sunriset__(2025, month, day, s->lon, s->lat, -35.0 / 60.0, 1, &rise, &set))
+				continue;
+			sunriset_unwrap(s->lon, &rise, &set);
+
+			best[0] = fmin(best[0], rise);
+			best[1] = fmax(best[1], rise);
+			best[2] = fmin(best[2], set);
+			best[3] = fmax(best[3], set);
+		}
+	}
+
+	/* Flat extremes may be a date off, that is seconds */
+	for (i = 0; i < 4; i++) {
+		if (fabs(e[i]->value - best[i]) * 3600.0 <= 30.0)
+			continue;
+		if (!fail++)
+			printf("FAIL: %s extreme %d is %.4f h on %02d-%02d, should be %.4f h\n",
+			       s->name, i, e[i]->value, e[i]->month, e[i]->day, best[i]);
+	}
+
+	printf("%-5s %8.2f %6.2f: extremes %s\n", s->name, s->lon, s->lat, fail ? "wrong" : "right");
+
+	return fail != 0;
+}
+
+int main(void)
+{
+	static struct crossings c[NELEMS(sites)];
+	size_t i;
+	int rc = 0;
+
+	for (i = 0; i < NELEMS(sites); i++) {
+		scan(&sites[i], &c[i]);
+		rc |= next(&sites[i], &c[i]);
+		rc |= extremes(&sites[i]);
+	}
+
+	for (i = 0; i < 4; i++)
+		rc |= fleet(c, YEAR + i * 365 * 86400 / 4, YEAR + (i + 1) * 365 * 86400 / 4);
+
+	return rc;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,369 @@
+/*
+
+Annual extremes of sunrise, sunset and day length
+
+The earliest and latest rise and set of a year, and its longest and
+shortest day, without computing all of its days.  The times of rise
+and set, and the cosine of the diurnal arc from which the day length
+follows, are smooth curves over the year, once the times are moved to
+the local day of each date with sunriset_unwrap().  They are sampled
+every STEP days, and each sample that is lower, or higher, than its
+neighbours brackets a local extreme, which Brent's method then narrows
+down to a fraction of a day.  The two dates nearest to it are evaluated
+exactly as by __sunriset__(), and the best of all the local extremes of
+a curve is the answer.  That is a hundred or so evaluations instead of
+365.
+
+Inside the polar circles the Sun does not rise or set on some dates,
+and the earliest or latest rise or set is then often the first or last
+date it does.  Each stretch of polar day or night contains a solstice,
+so both solstices are sampled too, and where two samples differ in
+whether the Sun rises and sets, the date where that changes is found by
+bisection and sampled as well.  Rise and set are then only searched
+within runs of dates that have them.  The cosine of the diurnal arc is
+defined on all dates, so the longest day is the date the Sun is
+highest, also in polar day, where the day length is 24 hours.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+/* Days between samples, and the most samples of a year */
+#define STEP     23
+#define SAMPLES  64
+
+/* Mean daily motion of the Sun, degrees */
+#define DAILY    0.9856002585
+
+/* Narrow the extreme down to this fraction of a day */
+#define TOL      0.2
+
+/* Value of a curve on a date without rise and set */
+#define NONE     1e9
+
+#define GOLD     0.3819660112501051
+
+enum { RISE, SET, COST, CURVES };
+
+struct year {
+	double d0;		/* d of 12h local mean solar time, January 1 */
+	double lon, lat;
+	double altit;
+	int    upper_limb;
+};
+
+struct sample {
+	double x;		/* Days since January 1 */
+	int    rc;		/* As __sunriset__() */
+	double v[CURVES];
+};
+
+/* As __sunriset__(), for x days after January 1, also between dates */
+static void eval(const struct year *y, double x, struct sample *s)
+{
+	double d, sidtime, sRA, sdec, sr, tsouth, altit, cost, t;
+
+	d = y->d0 + x;
+	sidtime = revolution(GMST0(d) + 180.0 + y->lon);
+	sun_RA_dec(d, &sRA, &sdec, &sr);
+	tsouth = 12.0 - rev180(sidtime - sRA) / 15.0;
+
+	altit = y->altit;
+	if (y->upper_limb)
+		altit -= 0.2666 / sr;
+
+	cost = (sind(altit) - sind(y->lat) * sind(sdec)) / (cosd(y->lat) * cosd(sdec));
+	if (cost >= 1.0)
+		s->rc = -1, t = 0.0;
+	else if (cost <= -1.0)
+		s->rc = +1, t = 12.0;
+	else
+		s->rc = 0, t = acosd(cost) / 15.0;
+
+	s->x       = x;
+	s->v[RISE] = tsouth - t;
+	s->v[SET]  = tsouth + t;
+	s->v[COST] = cost;
+
+	/* Near the date line tsouth would jump by a day where it crosses 0h UT */
+	sunriset_unwrap(y->lon, &s->v[RISE], &s->v[SET]);
+}
+
+/* Value of curve k to minimise, sign -1 to find its maximum */
+static double value(const struct sample *s, int k, int sign)
+{
+	if (k != COST && s->rc)
+		return NONE;
+
+	return sign * s->v[k];
+}
+
+static double f(const struct year *y, double x, int k, int sign)
+{
+	struct sample s;
+
+	eval(y, x, &s);
+	return value(&s, k, sign);
+}
+
+/* Brent's method, minimum of curve k in [a, b], starting from x */
+static double brent(const struct year *y, int k, int sign, double a, double b, double x)
+{
+	double w, v, fx, fw, fv, d = 0.0, e = 0.0;
+	int i;
+
+	w = v = x;
+	fx = fw = fv = f(y, x, k, sign);
+
+	for (i = 0; i < 50; i++) {
+		double m = (a + b) / 2.0, u, fu;
+
+		if (fabs(x - m) <= 2.0 * TOL - (b - a) / 2.0)
+			break;
+
+		if (fabs(e) > TOL) {
+			/* Parabola through x, w and v */
+			double r = (x - w) * (fx - fv);
+			double q = (x - v) * (fx - fw);
+			double p = (x - v) * q - (x - w) * r, olde = e;
+
+			q = 2.0 * (q - r);
+			if (q > 0.0)
+				p = -p;
+			q = fabs(q);
+			e = d;
+			if (fabs(p) >= fabs(0.5 * q * olde) || p <= q * (a - x) || p >= q * (b - x)) {
+				e = x >= m ? a - x : b - x;
+				d = GOLD * e;
+			} else {
+				d = p / q;
+				if (x + d - a < 2.0 * TOL || b - x - d < 2.0 * TOL)
+					d = x < m ? TOL : -TOL;
+			}
+		} else {
+			e = x >= m ? a - x : b - x;
+			d = GOLD * e;
+		}
+
+		u  = fabs(d) >= TOL ? x + d : x + (d > 0.0 ? TOL : -TOL);
+		fu = f(y, u, k, sign);
+		if (fu <= fx) {
+			if (u >= x)
+				a = x;
+			else
+				b = x;
+			v = w, fv = fw;
+			w = x, fw = fx;
+			x = u, fx = fu;
+		} else {
+			if (u < x)
+				a = u;
+			else
+				b = u;
+			if (fu <= fw || w == x) {
+				v = w, fv = fw;
+				w = u, fw = fu;
+			} else if (fu <= fv || v == x || v == w) {
+				v = u, fv = fu;
+			}
+		}
+	}
+
+	return x;
+}
+
+/* Days after January 1 of the solstice near x, the Sun at ecliptic longitude lon */
+static double solstice(const struct year *y, double lon, double x)
+{
+	double slon, sr;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		sunpos(y->d0 + x, &slon, &sr);
+		x += rev180(lon - slon) / DAILY;
+	}
+
+	return floor(x + 0.5);
+}
+
+/* Add the samples of dates in (a, b] where the Sun starts or stops rising */
+static int transitions(const struct year *y, const struct sample *a, const struct sample *b,
+		       struct sample *out, int n)
+{
+	while (a->rc != b->rc && n < SAMPLES - 2) {
+		long lo = (long)a->x, hi = (long)b->x;
+		struct sample s;
+
+		/* First date after a not like a */
+		while (hi - lo > 1) {
+			long mid = lo + (hi - lo) / 2;
+
+			eval(y, mid, &s);
+			if (s.rc == a->rc)
+				lo = mid;
+			else
+				hi = mid;
+		}
+
+		if (lo > (long)a->x)
+			eval(y, lo, &out[n++]);
+		if (hi == (long)b->x)
+			break;
+		eval(y, hi, &out[n++]);
+		a = &out[n - 1];
+	}
+
+	return n;
+}
+
+/* Earliest, sign +1, or latest, sign -1, of curve k */
+static void extreme(const struct year *y, const struct sample *s, int n, int k, int sign,
+		    double *best, int *day)
+{
+	int i;
+
+	*best = NONE;
+	*day  = -1;
+	for (i = 0; i < n; i++) {
+		double v = value(&s[i], k, sign), a, b, x;
+		int lo, j;
+
+		if (v >= NONE)
+			continue;
+		if (i > 0 && value(&s[i - 1], k, sign) < v)
+			continue;
+		if (i < n - 1 && value(&s[i + 1], k, sign) < v)
+			continue;
+
+		/* A local extreme, narrowed down within its valid neighbours */
+		a = i > 0 && value(&s[i - 1], k, sign) < NONE ? s[i - 1].x : s[i].x;
+		b = i < n - 1 && value(&s[i + 1], k, sign) < NONE ? s[i + 1].x : s[i].x;
+		x = b - a > 1.0 ? brent(y, k, sign, a, b, s[i].x) : s[i].x;
+
+		if (v < *best) {
+			*best = v;
+			*day  = (int)s[i].x;
+		}
+
+		lo = (int)floor(x);
+		for (j = lo; j <= lo + 1; j++) {
+			double fj;
+
+			if (j < a || j > b)
+				continue;
+			fj = f(y, j, k, sign);
+			if (fj < *best) {
+				*best = fj;
+				*day  = j;
+			}
+		}
+	}
+}
+
+/* Month and day of the day'th day, from 0, of year */
+static void date(int year, int day, int *month, int *mday)
+{
+	static const int mdays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+	int m;
+
+	for (m = 0; m < 11; m++) {
+		int len = mdays[m] + (m == 1 ? leap : 0);
+
+		if (day < len)
+			break;
+		day -= len;
+	}
+
+	*month = m + 1;
+	*mday  = day + 1;
+}
+
+static void result(const struct year *y, int year, int k, int day,
+		   struct sunriset_extreme *ex)
+{
+	struct sample s;
+
+	ex->month = ex->day = 0;
+	ex->value = 0.0;
+	if (day < 0)
+		return;
+
+	date(year, day, &ex->month, &ex->day);
+	eval(y, day, &s);
+	if (k != COST)
+		ex->value = s.v[k];
+	else if (s.rc)
+		ex->value = s.rc > 0 ? 24.0 : 0.0;
+	else
+		ex->value = s.v[SET] - s.v[RISE];
+}
+
+void sunriset_extremes( int year, double lon, double lat, double altit, int upper_limb,
+                        struct sunriset_extremes *ex )
+{
+	struct sample grid[SAMPLES], s[SAMPLES];
+	struct year y;
+	double x[2];
+	int days, ng = 0, n = 0, i, k;
+
+	days = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0 ? 366 : 365;
+
+	y.d0         = days_since_2000_Jan_0(year, 1, 1) + 0.5 - lon / 360.0;
+	y.lon        = lon;
+	y.lat        = lat;
+	y.altit      = altit;
+	y.upper_limb = upper_limb;
+
+	/* Every STEP days, the solstices and the last day, in order */
+	x[0] = solstice(&y,  90.0, 171.0);
+	x[1] = solstice(&y, 270.0, 355.0);
+	for (i = 0, k = 0; ; i = i + STEP < days - 1 ? i + STEP : days - 1) {
+		for (; k < 2 && x[k] <= i; k++) {
+			if (x[k] < i)
+				eval(&y, x[k], &grid[ng++]);
+		}
+		eval(&y, i, &grid[ng++]);
+		if (i == days - 1)
+			break;
+	}
+
+	for (i = 0; i < ng; i++) {
+		s[n++] = grid[i];
+		if (i < ng - 1)
+			n = transitions(&y, &grid[i], &grid[i + 1], s, n);
+	}
+
+	for (k = 0; k < CURVES; k++) {
+		struct sunriset_extreme *lo, *hi;
+		double best;
+		int day;
+
+		switch (k) {
+		case RISE:
+			lo = &ex->earliest_rise, hi = &ex->latest_rise;
+			break;
+		case SET:
+			lo = &ex->earliest_set, hi = &ex->latest_set;
+			break;
+		default:	/* The lowest cosine is the longest day */
+			lo = &ex->longest, hi = &ex->shortest;
+			break;
+		}
+
+		extreme(&y, s, n, k, +1, &best, &day);
+		result(&y, year, k, day, lo);
+		extreme(&y, s, n, k, -1, &best, &day);
+		result(&y, year, k, day, hi);
+	}
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
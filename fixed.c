@@ -0,0 +1,291 @@
+/*
+
+Fixed-point SUNRISET for controllers without an FPU
+
+On Cortex-M0/M3 class parts, and most other small controllers, every
+double in sunriset.c is a soft-float library call, and each sin() or
+atan2() a few thousand cycles of them.  __sunriset_fixed__() and
+__daylen_fixed__() are __sunriset__() and __daylen__() in integers
+only, with no libm and no floating point at run time.
+
+Angles are binary, 2^32 per turn, so the revolution() of an angle is
+the wrap around of its uint32_t.  Sines, cosines and the Sun's unit
+vector are Q30, 2^30 is 1.0.  Sine and cosine are a series in the
+fraction of a quarter turn, and arc tangent a series after reduction
+to +-22.5 degrees, both with a truncation error below 1E-9.  Square
+roots are integer, bit by bit.  The time of day follows with a turn
+being 86400 seconds.  The linear terms of the orbital elements are
+kept as whole days plus a Q32 fraction, times 64-bit rates, so the
+angles are exact to a few binary units, well below 1E-6 degrees, over
+1801-2099.
+
+Against __sunriset__() in double precision, over 2000-2099, the rise
+and set times differ by at most 1.5 seconds up to 65 degrees latitude,
+and 20 seconds closer to the poles.  Within a few minutes of the edge
+of polar day or night, where the Sun only just rises or sets, any
+rounding is amplified, as it is in the double version, to a minute or
+so, and the two may disagree whether the Sun rises at all.  `make
+check` runs fixedcheck.c, which holds the code to these bounds.
+
+There are no tables but the two series, the code is under 2 kB and the
+stack below 200 bytes, at -Os on x86-64.  On 32-bit targets the 64-bit
+divisions, four per call, are the only library calls, to libgcc.
+
+Released to the public domain
+
+ */
+#include "sunriset_fixed.h"
+
+/* Degrees as binary angles, and rates in binary angles per day, Q16 */
+#define M0       4247806169u		/* 356.0470, mean anomaly */
+#define M1       770616138354LL		/* 0.9856002585 */
+#define W0       3375610458u		/* 282.9404, perihelion */
+#define W1       36821227LL		/* 4.70935E-5 */
+#define G0       1180965683u		/* 180 + M + w, GMST0 */
+#define G1       770652959581LL
+#define OBL0     279641742u		/* 23.4393, obliquity of the ecliptic */
+#define OBL1     -278582LL		/* -3.563E-7 */
+#define RADIUS   3180662		/* 0.2666, apparent radius at 1 AU */
+
+/* Eccentricity, Q32, and its rate per day, Q16 of that */
+#define E0       71764609
+#define E1       323978LL
+
+#define ONE      (1LL << 30)
+#define QUARTER  0x40000000u
+#define HALF     0x80000000u
+#define TAN8     444758426LL		/* tan(22.5), Q30 */
+#define RADBAM   2734261102LL		/* Radians to binary angles, Q32 / 4 */
+#define RADQ32   683565276LL		/* Radians to binary angles, Q32 */
+
+/* sin(z pi/2) = z (s0 + z^2 (s1 + ...)), Q30 */
+static const int32_t sine[] = {
+	1686629713, -693598668, 85569306, -5026995, 172272, -3864, 61
+};
+
+/* atan(t) = t (a0 + t^2 (a1 + ...)), |t| <= tan(22.5), Q30 */
+static const int32_t arctan[] = {
+	1073741824, -357913941, 214748365, -153391689, 119304647,
+	-97612893, 82595525, -71582788, 63161284
+};
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+
+struct sun {
+	uint32_t ra;			/* Right ascension */
+	int32_t  sindec, cosdec;	/* Declination, Q30 */
+	int32_t  r;			/* Distance, AU, Q30 */
+};
+
+static int32_t mul(int64_t a, int64_t b)
+{
+	return (int32_t)((a * b) >> 30);
+}
+
+/* Series in x^2, Q30, then times x */
+static int64_t series(const int32_t *c, int n, int64_t x)
+{
+	int64_t x2 = (x * x) >> 30, p = c[n - 1];
+
+	while (--n > 0)
+		p = c[n - 1] + ((p * x2) >> 30);
+
+	return (p * x) >> 30;
+}
+
+static int32_t fsin(uint32_t a)
+{
+	uint32_t z = a & (QUARTER - 1);
+	int64_t s;
+
+	/* Fold the quadrants onto the first */
+	if (a & QUARTER)
+		z = QUARTER - z;
+	s = series(sine, NELEMS(sine), z);
+
+	return (int32_t)(a & HALF ? -s : s);
+}
+
+static int32_t fcos(uint32_t a)
+{
+	return fsin(a + QUARTER);
+}
+
+static uint32_t fatan2(int32_t y, int32_t x)
+{
+	int64_t ax = x < 0 ? -(int64_t)x : x, ay = y < 0 ? -(int64_t)y : y;
+	int64_t lo = ay < ax ? ay : ax, hi = ay < ax ? ax : ay, t;
+	uint32_t a = 0;
+
+	if (!hi)
+		return 0;
+
+	/* atan(lo / hi), 0..45 degrees, as 45 + atan of the rest above 22.5 */
+	if ((lo << 30) > TAN8 * hi) {
+		t = ((lo - hi) << 30) / (lo + hi);
+		a = QUARTER / 2;
+	} else {
+		t = (lo << 30) / hi;
+	}
+	a += (uint32_t)((series(arctan, NELEMS(arctan), t) * RADBAM) >> 32);
+
+	if (ay > ax)
+		a = QUARTER - a;
+	if (x < 0)
+		a = HALF - a;
+	if (y < 0)
+		a = -a;
+
+	return a;
+}
+
+static uint32_t fsqrt(uint64_t x)
+{
+	uint64_t r = 0, b = 1ULL << 62;
+
+	while (b > x)
+		b >>= 2;
+	while (b) {
+		if (x >= r + b) {
+			x -= r + b;
+			r = (r >> 1) + b;
+		} else {
+			r >>= 1;
+		}
+		b >>= 2;
+	}
+
+	return (uint32_t)r;
+}
+
+/* a + b (day + f), binary angles, b Q16 per day and f Q32 of a day */
+static uint32_t linear(uint32_t a, int64_t b, int32_t day, int64_t f)
+{
+	return a + (uint32_t)((b * day) >> 16) + (uint32_t)((b * (f >> 16)) >> 32);
+}
+
+/* Binary angle, signed, to seconds of a day */
+static int32_t seconds(int32_t a)
+{
+	return (int32_t)(((int64_t)a * 86400 + HALF) >> 32);
+}
+
+/* As days_since_2000_Jan_0() in sunriset.h */
+static int32_t days(int y, int m, int d)
+{
+	return 367L * y - ((7 * (y + ((m + 9) / 12))) / 4) + ((275 * m) / 9) + d - 730530L;
+}
+
+/* As sunpos() and sun_RA_dec() */
+static void sun(int32_t day, int64_t f, struct sun *s)
+{
+	uint32_t M, w, E, lon, obl;
+	int32_t e, sM, cM, cE, x, y, sl, cl;
+	int64_t de;
+
+	M = linear(M0, M1, day, f);
+	w = linear(W0, W1, day, f);
+	e = E0 - (int32_t)((E1 * day) >> 16);
+
+	/* Eccentric anomaly, E = M + e sin(M) (1 + e cos(M)) radians */
+	sM = fsin(M);
+	cM = fcos(M);
+	de = ((int64_t)e * sM) >> 30;
+	de = (de * ((1LL << 32) + (((int64_t)e * cM) >> 30))) >> 32;
+	E  = M + (uint32_t)((de * RADQ32) >> 32);
+
+	/*
+	 * Position in the orbit and true anomaly, with sqrt(1 - e^2) as
+	 * 1 - e^2 / 2, good to 1E-8, and the distance r = 1 - e cos(E)
+	 */
+	e  >>= 2;
+	cE   = fcos(E);
+	x    = cE - e;
+	y    = mul(fsin(E), ONE - (((int64_t)e * e) >> 31));
+	s->r = (int32_t)ONE - mul(e, cE);
+	lon  = fatan2(y, x) + w;
+
+	/* Ecliptic to equatorial, on the unit vector */
+	obl = linear(OBL0, OBL1, day, f);
+	sl  = fsin(lon);
+	cl  = fcos(lon);
+	y   = mul(sl, fcos(obl));
+
+	s->ra     = fatan2(y, cl);
+	s->sindec = mul(sl, fsin(obl));
+	s->cosdec = fsqrt((uint64_t)((int64_t)cl * cl + (int64_t)y * y));
+}
+
+/* Half the diurnal arc in seconds, and the return code of __sunriset__() */
+static int arc(const struct sun *s, int32_t lat, int32_t altit, int upper_limb, int32_t *t)
+{
+	int64_t num, den, cost;
+
+	/* Apparent radius, 1 / r as 2 - r, good to 3E-4 of 0.27 degrees */
+	if (upper_limb)
+		altit -= (int32_t)((RADIUS * ((2 * ONE) - s->r)) >> 30);
+
+	num = fsin(altit) - (((int64_t)fsin(lat) * s->sindec) >> 30);
+	den = ((int64_t)fcos(lat) * s->cosdec) >> 30;
+	if (num >= den) {
+		*t = 0;
+		return -1;	/* Sun always below altit */
+	}
+	if (num <= -den) {
+		*t = 43200;
+		return +1;	/* Sun always above altit */
+	}
+
+	cost = (num << 30) / den;
+	*t = seconds(fatan2(fsqrt((uint64_t)(ONE * ONE - cost * cost)), (int32_t)cost));
+
+	return 0;
+}
+
+int __sunriset_fixed__( int year, int month, int day, int32_t lon, int32_t lat,
+                        int32_t altit, int upper_limb, int32_t *trise,
+                        int32_t *tset )
+{
+	struct sun s;
+	uint32_t sidtime;
+	int32_t d, tsouth, t;
+	int64_t f;
+	int rc;
+
+	/* 12h local mean solar time, 0.5 - lon / 360 days */
+	d = days(year, month, day);
+	f = (int64_t)HALF - lon;
+	sun(d, f, &s);
+
+	/* Local sidereal time, and time when the Sun is at south */
+	sidtime = linear(G0, G1, d, f) + HALF + (uint32_t)lon;
+	tsouth  = 43200 - seconds((int32_t)(sidtime - s.ra));
+
+	rc = arc(&s, lat, altit, upper_limb, &t);
+	*trise = tsouth - t;
+	*tset  = tsouth + t;
+
+	return rc;
+}
+
+int32_t __daylen_fixed__( int year, int month, int day, int32_t lon,
+                          int32_t lat, int32_t altit, int upper_limb )
+{
+	struct sun s;
+	int32_t d, t;
+	int64_t f;
+
+	d = days(year, month, day);
+	f = (int64_t)HALF - lon;
+	sun(d, f, &s);
+	arc(&s, lat, altit, upper_limb, &t);
+
+	return 2 * t;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
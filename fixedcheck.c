@@ -0,0 +1,134 @@
+/*
+
+Check of the fixed-point SUNRISET against __sunriset__()
+
+Runs __sunriset_fixed__() and __daylen_fixed__() next to the double
+precision versions over 2000-2099, every week, at all four standard
+altitudes and a spread of longitudes, and fails if the times differ by
+more than the bounds documented in fixed.c and the README: 1.5 seconds
+up to 65 degrees latitude and 20 seconds closer to the poles.  Within a
+few minutes of the edge of polar day or night, where the Sun only just
+rises or sets, any rounding is amplified and the two may even disagree
+whether the Sun rises at all.  Those cases are only counted.  Build and
+run with `make check`.
+
+Released to the public domain
+
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sunriset.h"
+#include "sunriset_fixed.h"
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+#define EDGE   (5.0 / 60.0)	/* Hours from polar day or night */
+
+struct band {
+	const char *name;
+	double      min, max;	/* Latitude, both hemispheres */
+	double      bound;	/* Seconds */
+} bands[] = {
+	{ "temperate", 0.0, 65.0,  1.5 },
+	{ "polar",    65.0, 90.0, 20.0 },
+};
+
+struct altitude {
+	double altit;
+	int    upper_limb;
+} altitudes[] = {
+	{ -35.0 / 60.0, 1 },
+	{  -6.0,        0 },
+	{ -12.0,        0 },
+	{ -18.0,        0 },
+};
+
+static double diff(double hours, int32_t seconds)
+{
+	return fabs(hours * 3600.0 - seconds);
+}
+
+static int check(struct band *b)
+{
+	double worst = 0.0, wlat = 0.0, wlon = 0.0;
+	long n = 0, edge = 0, disagree = 0;
+	int wyear = 0, wdoy = 0;
+	int year, doy, i, j, k;
+
+	for (year = 2000; year <= 2099; year++) {
+		for (doy = 1; doy <= 365; doy += 7) {
+			for (i = -13; i <= 13; i++) {
+				double lat = (i < 0 ? -1 : 1) * (b->min + (b->max - b->min) * abs(i) / 13.0);
+
+				for (j = 0; j < 8; j++) {
+					double lon = -179.0 + j * 47.3;
+
+					for (k = 0; k < (int)NELEMS(altitudes); k++) {
+						struct altitude *a = &altitudes[k];
+						int32_t flon = SUNRISET_FIXED_DEG(lon);
+						int32_t flat = SUNRISET_FIXED_DEG(lat);
+						int32_t falt = SUNRISET_FIXED_DEG(a->altit);
+						double rise, set, len, e;
+						int32_t frise, fset, flen;
+						int rc, frc;
+
+						rc  = __sunriset__(year, 1, doy, lon, lat, a->altit, a->upper_limb, &rise, &set);
+						frc = __sunriset_fixed__(year, 1, doy, flon, flat, falt, a->upper_limb, &frise, &fset);
+						len  = __daylen__(year, 1, doy, lon, lat, a->altit, a->upper_limb);
+						flen = __daylen_fixed__(year, 1, doy, flon, flat, falt, a->upper_limb);
+						n++;
+
+						if (rc != frc) {
+							disagree++;
+							continue;
+						}
+						if (!rc && (len < 2 * EDGE || len > 24.0 - 2 * EDGE)) {
+							edge++;
+							continue;
+						}
+
+						e = fmax(diff(rise, frise), diff(set, fset));
+						e = fmax(e, diff(len, flen));
+						if (e > worst) {
+							worst = e;
+							wlat  = lat;
+							wlon  = lon;
+							wyear = year;
+							wdoy  = doy;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	printf("%-9s |lat| %2.0f-%2.0f: %ld cases, worst %.3f s at lat %.2f lon %.1f %d day %d\n",
+	       b->name, b->min, b->max, n, worst, wlat, wlon, wyear, wdoy);
+	printf("%-9s %ld at the edge of polar day or night, %ld disagree whether the Sun rises\n",
+	       "", edge, disagree);
+
+	if (worst > b->bound) {
+		printf("FAIL: above the bound of %.2f s\n", b->bound);
+		return 1;
+	}
+	return 0;
+}
+
+int main(void)
+{
+	size_t i;
+	int rc = 0;
+
+	for (i = 0; i < NELEMS(bands); i++)
+		rc |= check(&bands[i]);
+
+	return rc;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
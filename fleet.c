@@ -0,0 +1,256 @@
+/*
+
+Schedule of switching events for a large fleet of devices
+
+Each device has a position, the altitude of the Sun it reacts to, e.g.
+sunset or civil twilight, and offsets for switching on at dusk and off
+at dawn.  The events are handed out one at a time in global time order
+by a k-way merge: a min-heap with one entry per device holds the time
+of that device's next event, and only when it is taken is the one after
+it computed.  Nothing but the next on and the next off event of each
+device is stored, so the memory is proportional to the fleet, not to
+the length of the window.
+
+A device's on events follow its sets, and its off events its rises, so
+each of the two is in date order.  The next one is found by evaluating
+the following dates until an event falls inside the window.  The Sun's
+position is computed only once per date, with sunriset_ephemeris_init()
+when the first device reaches it, and the devices then compute just the
+diurnal arc against it.  Near the date line that is moved to the local
+day of the date with sunriset_unwrap(), or once a year an event would
+be skipped, and another one computed for two dates.  The on and off
+events of a device are rarely more than a date apart, so each device
+also keeps the rise and set of the last date it evaluated.
+
+Released to the public domain
+
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sunriset.h"
+
+struct node {
+	time_t   when;
+	uint32_t device;
+};
+
+/* Next off, at rise, and on, at set, event of a device */
+enum { OFF, ON };
+
+struct device {
+	long   date[2];		/* Days since 1970 of the next event */
+	time_t when[2];		/* The event, end if there are no more */
+	long   last;		/* Date of rise and set below */
+	double rise, set;
+	int    rc;
+};
+
+struct sunriset_fleet {
+	const struct sunriset_device *dev;
+	size_t       n;
+	time_t       start, end;
+	long         first;	/* Dates first to last are searched */
+	long         last;
+	struct sunriset_ephemeris *eph;	/* Per date, computed when needed */
+	uint8_t     *valid;
+	struct device *state;
+	struct node *heap;
+	size_t       nheap;
+};
+
+static void sift_down(struct sunriset_fleet *f, size_t i)
+{
+	struct node x = f->heap[i];
+
+	while (1) {
+		size_t child = 2 * i + 1;
+
+		if (child >= f->nheap)
+			break;
+		if (child + 1 < f->nheap && f->heap[child + 1].when < f->heap[child].when)
+			child++;
+		if (x.when <= f->heap[child].when)
+			break;
+		f->heap[i] = f->heap[child];
+		i = child;
+	}
+	f->heap[i] = x;
+}
+
+/* The Sun's position on one date, shared by all devices */
+static const struct sunriset_ephemeris *ephemeris(struct sunriset_fleet *f, long day)
+{
+	size_t k = day - f->first;
+
+	if (!f->valid[k]) {
+		time_t midnight = (time_t)day * 86400;
+		struct tm tm;
+
+		gmtime_r(&midnight, &tm);
+		sunriset_ephemeris_init(&f->eph[k], 1900 + tm.tm_year, 1 + tm.tm_mon, tm.tm_mday);
+		f->valid[k] = 1;
+	}
+
+	return &f->eph[k];
+}
+
+/* Next event of kind k of device i, or end if there is none in the window */
+static void advance(struct sunriset_fleet *f, size_t i, int k)
+{
+	const struct sunriset_device *d = &f->dev[i];
+	struct device *s = &f->state[i];
+	long day;
+
+	for (day = s->date[k] + 1; day <= f->last; day++) {
+		time_t t;
+
+		if (s->last != day) {
+			s->rc = sunriset_ephemeris_eval(ephemeris(f, day), d->lon, d->lat,
+							d->altit, d->upper_limb, &s->rise, &s->set);
+			sunriset_unwrap(d->lon, &s->rise, &s->set);
+			s->last = day;
+		}
+
+		/* No switching on days the Sun does not cross altit */
+		if (s->rc)
+			continue;
+
+		if (k == ON)
+			t = (time_t)day * 86400 + (time_t)(s->set * 3600.0 + 0.5) + d->on_offset;
+		else
+			t = (time_t)day * 86400 + (time_t)(s->rise * 3600.0 + 0.5) + d->off_offset;
+
+		/* In date order, so none of the later dates is inside either */
+		if (t >= f->end)
+			break;
+		if (t >= f->start) {
+			s->date[k] = day;
+			s->when[k] = t;
+			return;
+		}
+	}
+
+	s->date[k] = f->last;
+	s->when[k] = f->end;
+}
+
+/* Which of the two events of a device is next, the earlier date on a tie */
+static int next(const struct device *s)
+{
+	if (s->when[ON] != s->when[OFF])
+		return s->when[ON] < s->when[OFF] ? ON : OFF;
+
+	return s->date[ON] < s->date[OFF] ? ON : OFF;
+}
+
+sunriset_fleet *sunriset_fleet_open(const struct sunriset_device *dev, size_t n,
+				    time_t start, time_t end)
+{
+	struct sunriset_fleet *f;
+	size_t i, days;
+
+	if (end <= start)
+		return NULL;
+
+	f = calloc(1, sizeof(*f));
+	if (!f)
+		return NULL;
+
+	/*
+	 * Events of a UT date fall within half a day of it, the offsets within
+	 * one more day, so cover the dates one day beyond the window
+	 */
+	f->first = (long)(start / 86400) - 1;
+	f->last  = (long)(end / 86400) + 1;
+	days     = f->last - f->first + 1;
+	if (days > 100) {
+		free(f);
+		return NULL;
+	}
+
+	f->dev   = dev;
+	f->n     = n;
+	f->start = start;
+	f->end   = end;
+	f->eph   = malloc(days * sizeof(*f->eph));
+	f->valid = calloc(days, 1);
+	f->state = malloc(n * sizeof(*f->state));
+	f->heap  = malloc(n * sizeof(*f->heap));
+	if (!f->eph || !f->valid || (n && (!f->state || !f->heap))) {
+		sunriset_fleet_close(f);
+		return NULL;
+	}
+
+	/* Seed the merge with the first event of each device */
+	for (i = 0; i < n; i++) {
+		struct device *s = &f->state[i];
+
+		s->date[OFF] = s->date[ON] = f->first - 1;
+		s->last = f->first - 1;
+		advance(f, i, ON);
+		advance(f, i, OFF);
+		if (s->when[next(s)] >= end)
+			continue;
+
+		f->heap[f->nheap].when   = s->when[next(s)];
+		f->heap[f->nheap].device = i;
+		f->nheap++;
+	}
+	for (i = f->nheap / 2; i-- > 0;)
+		sift_down(f, i);
+
+	return f;
+}
+
+int sunriset_fleet_next(sunriset_fleet *f, struct sunriset_fleet_event *ev)
+{
+	struct device *s;
+	struct node *top;
+	size_t i;
+	int k;
+
+	if (!f || !f->nheap)
+		return 0;
+
+	top = &f->heap[0];
+	i   = top->device;
+	s   = &f->state[i];
+	k   = next(s);
+
+	ev->when   = s->when[k];
+	ev->device = i;
+	ev->on     = k == ON;
+
+	/* Only now is the device's following event computed */
+	advance(f, i, k);
+	k = next(s);
+	if (s->when[k] < f->end)
+		top->when = s->when[k];
+	else
+		*top = f->heap[--f->nheap];
+	if (f->nheap)
+		sift_down(f, 0);
+
+	return 1;
+}
+
+void sunriset_fleet_close(sunriset_fleet *f)
+{
+	if (!f)
+		return;
+
+	free(f->eph);
+	free(f->valid);
+	free(f->state);
+	free(f->heap);
+	free(f);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,201 @@
+/*
+
+Prepared observer locations
+
+Controllers that query the same few places day after day need not
+recompute what only depends on the place.  A sunriset_location holds
+the sine and cosine of the latitude, the longitude terms of the local
+noon and sidereal time, and the sine and cosine of each of the standard
+altitudes: rise/set and civil, nautical and astronomical twilight.  The
+functions below are then __sunriset__() and __daylen__() with those
+terms looked up instead of computed.  The sine and cosine of the Sun's
+declination are also taken straight from its unit vector, instead of
+via the angle, which saves two atan2() and two more sin()/cos() calls.
+Like __daylen__() this always uses the Kepler ephemeris of sunpos().
+
+For the upper limb the altitude depends on the Sun's distance, which
+changes with the date.  The sine of altit - sradius is then expanded as
+sin(altit)cos(sradius) - cos(altit)sin(sradius), with the short series
+of the small angle sradius, which is exact to double precision.
+
+Each location also has a precision tier, SUNRISET_FAST or PRECISE, so
+the same code can serve locations with different needs.  The precise
+tier has nothing to prepare and calls __sunriset_precise__().
+
+Released to the public domain
+
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "sunriset.h"
+
+struct altitude {
+	double altit;
+	int    upper_limb;
+	double sin, cos;
+};
+
+struct sunriset_location {
+	double lon, lat;
+	int    tier;
+	double noon;		/* 0.5 - lon/360, local noon in days */
+	double lst;		/* 180 + lon, for the local sidereal time */
+	double sinlat, coslat;
+	struct altitude alt[SUNRISET_ALTITUDES];
+};
+
+/* Same order as SUNRISET_RISE_SET .. SUNRISET_ASTRONOMICAL */
+static const struct {
+	double altit;
+	int    upper_limb;
+} standard[SUNRISET_ALTITUDES] = {
+	{ -35.0 / 60.0, 1 },
+	{  -6.0,        0 },
+	{ -12.0,        0 },
+	{ -18.0,        0 },
+};
+
+/* Sine of the altitude to cross, less the apparent radius for the upper limb */
+static double sinalt(const struct altitude *a, double sr)
+{
+	double r, r2;
+
+	if (!a->upper_limb)
+		return a->sin;
+
+	r  = 0.2666 / sr * DEGRAD;
+	r2 = r * r;
+
+	return a->sin * (1.0 - r2 / 2.0 + r2 * r2 / 24.0) -
+	       a->cos * r * (1.0 - r2 / 6.0 + r2 * r2 / 120.0);
+}
+
+sunriset_location *sunriset_location_open( double lon, double lat, int tier )
+{
+	struct sunriset_location *loc;
+	int i;
+
+	if (tier != SUNRISET_FAST && tier != SUNRISET_PRECISE)
+		return NULL;
+
+	loc = malloc(sizeof(*loc));
+	if (!loc)
+		return NULL;
+
+	loc->lon    = lon;
+	loc->lat    = lat;
+	loc->tier   = tier;
+	loc->noon   = 0.5 - lon / 360.0;
+	loc->lst    = 180.0 + lon;
+	loc->sinlat = sind(lat);
+	loc->coslat = cosd(lat);
+
+	for (i = 0; i < SUNRISET_ALTITUDES; i++) {
+		struct altitude *a = &loc->alt[i];
+
+		a->altit      = standard[i].altit;
+		a->upper_limb = standard[i].upper_limb;
+		a->sin        = sind(a->altit);
+		a->cos        = cosd(a->altit);
+	}
+
+	return loc;
+}
+
+void sunriset_location_close( sunriset_location *loc )
+{
+	free(loc);
+}
+
+int __sunriset_at__( const sunriset_location *loc, int year, int month, int day,
+		     int which, double *trise, double *tset )
+{
+	const struct altitude *a;
+	double d, obl_ecl, sr, slon, sinlon, x, y, sRA, sin_sdecl, cos_sdecl,
+	       tsouth, sidtime, cost, t;
+	int rc = 0;
+
+	if (which < 0 || which >= SUNRISET_ALTITUDES)
+		return -1;
+	a = &loc->alt[which];
+
+	if (loc->tier == SUNRISET_PRECISE)
+		return __sunriset_precise__(year, month, day, loc->lon, loc->lat,
+					    a->altit, a->upper_limb, trise, tset);
+
+	/* As __sunriset__(), at 12h local mean solar time */
+	d = days_since_2000_Jan_0(year, month, day) + loc->noon;
+	sidtime = revolution(GMST0(d) + loc->lst);
+
+	/* Unit vector to the Sun, equatorial, see sun_RA_dec() */
+	obl_ecl = 23.4393 - 3.563E-7 * d;
+	sunpos(d, &slon, &sr);
+	sinlon    = sind(slon);
+	x         = cosd(slon);
+	y         = sinlon * cosd(obl_ecl);
+	sin_sdecl = sinlon * sind(obl_ecl);
+	cos_sdecl = sqrt(x * x + y * y);
+	sRA       = atan2d(y, x);
+	tsouth    = 12.0 - rev180(sidtime - sRA) / 15.0;
+
+	cost = (sinalt(a, sr) - loc->sinlat * sin_sdecl) / (loc->coslat * cos_sdecl);
+	if (cost >= 1.0)
+		rc = -1, t = 0.0;
+	else if (cost <= -1.0)
+		rc = +1, t = 12.0;
+	else
+		t = acosd(cost) / 15.0;
+
+	*trise = tsouth - t;
+	*tset  = tsouth + t;
+
+	return rc;
+}
+
+double __daylen_at__( const sunriset_location *loc, int year, int month, int day,
+		      int which )
+{
+	const struct altitude *a;
+	double d, obl_ecl, sr, slon, sin_sdecl, cos_sdecl, cost;
+
+	if (which < 0 || which >= SUNRISET_ALTITUDES)
+		return 0.0;
+	a = &loc->alt[which];
+
+	if (loc->tier == SUNRISET_PRECISE) {
+		double rise, set;
+
+		switch (__sunriset_precise__(year, month, day, loc->lon, loc->lat,
+					     a->altit, a->upper_limb, &rise, &set)) {
+		case +1:
+			return 24.0;
+		case -1:
+			return 0.0;
+		}
+		return set - rise;
+	}
+
+	/* As __daylen__() */
+	d = days_since_2000_Jan_0(year, month, day) + loc->noon;
+	obl_ecl = 23.4393 - 3.563E-7 * d;
+	sunpos(d, &slon, &sr);
+
+	sin_sdecl = sind(obl_ecl) * sind(slon);
+	cos_sdecl = sqrt(1.0 - sin_sdecl * sin_sdecl);
+
+	cost = (sinalt(a, sr) - loc->sinlat * sin_sdecl) / (loc->coslat * cos_sdecl);
+	if (cost >= 1.0)
+		return 0.0;
+	if (cost <= -1.0)
+		return 24.0;
+
+	return (2.0 / 15.0) * acosd(cost);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
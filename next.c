@@ -0,0 +1,127 @@
+/*
+
+Next rise or set of the Sun, also through polar day and night
+
+Starting from the UT date before the given time, the events of each date
+are computed with __sunriset__() until one is found after it.  That is
+one or two dates, except at high latitudes, where the Sun may stay above
+or below the altitude for months.  Whether it does depends only on its
+declination: the Sun is always above altit when its lower transit is,
+at |lat + dec| - 90, and always below when its upper transit is, at
+90 - |lat - dec|.  Setting either equal to altit gives the declination
+where the polar day or night ends, and with sin(dec) = sin(obl)sin(lon)
+the Sun's ecliptic longitude at that moment.  The date is then found by
+Newton's method on the longitude from sunpos(), which advances about a
+degree a day, so a whole polar night is skipped in a few evaluations.
+
+Near the date line __sunriset__() gives the events of the date before,
+or after, once a year, when the time of south crosses 0h UT.  The
+events are first moved to the local day of each date with
+sunriset_unwrap(), so that none is skipped.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+/* Mean daily motion of the Sun, degrees */
+#define DAILY   0.9856002585
+
+/* Dates to search, more than a year of polar day or night is an error */
+#define SEARCH  400
+
+/* Days since 1970 of the UT date t falls on */
+static long date_of(time_t t)
+{
+	return (long)floor(t / 86400.0);
+}
+
+/*
+ * Day, since 1970, shortly before the polar day (rc +1) or night (rc -1)
+ * at day ends, or -1 if it never does
+ */
+static long skip(long day, int rc, double lat, double altit, int upper_limb)
+{
+	double d, slon, sr, obl, dec, dec_end, x, lon[2], dd = 0.0;
+	int i, k;
+
+	d   = day - 10956 + 0.5;
+	obl = 23.4393 - 3.563E-7 * d;
+	sunpos(d, &slon, &sr);
+	dec = asind(sind(obl) * sind(slon));
+	if (upper_limb)
+		altit -= 0.2666 / sr;
+
+	/* Declination where the transit that keeps the Sun up, or down, meets altit */
+	if (rc > 0) {
+		if (fabs(lat + dec) - 90.0 <= altit)
+			return day + 1;	/* At the edge, let __sunriset__() decide */
+		dec_end = (lat + dec > 0.0 ? 90.0 + altit : -90.0 - altit) - lat;
+	} else {
+		if (90.0 - fabs(lat - dec) >= altit)
+			return day + 1;
+		dec_end = lat - (lat - dec > 0.0 ? 90.0 - altit : -90.0 + altit);
+	}
+
+	x = sind(dec_end) / sind(obl);
+	if (x <= -1.0 || x >= 1.0)
+		return -1;
+
+	/* The two longitudes with that declination, the nearer one ahead ends it */
+	lon[0] = asind(x);
+	lon[1] = 180.0 - lon[0];
+	k = revolution(lon[0] - slon) < revolution(lon[1] - slon) ? 0 : 1;
+
+	dd = revolution(lon[k] - slon) / DAILY;
+	for (i = 0; i < 4; i++) {
+		sunpos(d + dd, &slon, &sr);
+		dd += rev180(lon[k] - slon) / DAILY;
+	}
+
+	/* One day early, to leave the exact date to __sunriset__() */
+	if (dd < 2.0)
+		return day + 1;
+	return day + (long)floor(dd) - 1;
+}
+
+time_t sunriset_next( time_t t, double lon, double lat, double altit,
+                      int upper_limb, int rise )
+{
+	long day = date_of(t) - 1;
+	int i;
+
+	for (i = 0; i < SEARCH; i++) {
+		time_t midnight = (time_t)day * 86400;
+		double trise, tset, h;
+		struct tm tm;
+		int rc;
+
+		gmtime_r(&midnight, &tm);
+		rc = __sunriset__(1900 + tm.tm_year, 1 + tm.tm_mon, tm.tm_mday, lon, lat,
+				  altit, upper_limb, &trise, &tset);
+		if (rc) {
+			day = skip(day, rc, lat, altit, upper_limb);
+			if (day < 0)
+				return (time_t)-1;
+			continue;
+		}
+
+		/* Each date's events a day apart, also near the date line */
+		sunriset_unwrap(lon, &trise, &tset);
+		h = rise ? trise : tset;
+		if (midnight + (time_t)floor(h * 3600.0 + 0.5) > t)
+			return midnight + (time_t)floor(h * 3600.0 + 0.5);
+		day++;
+	}
+
+	return (time_t)-1;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
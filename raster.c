@@ -0,0 +1,199 @@
+/*
+
+Global raster of sunrise, sunset and day length
+
+Computes the events of one date for every cell of a regular lat/lon
+grid, e.g. 3600 x 1800 cells at 0.1 degrees, and writes them to a file
+of three bands: rise, set and day length.  Either as float32 hours UT,
+NaN where the Sun does not rise or set, or as int16 minutes UT, with
+RASTER_NONE.  The file starts with a small header, see raster.h, then
+each band follows in full, rows from north to south, cells from west to
+east, in the byte order of the host.
+
+The Sun's position is computed once for the date, the per-date
+ephemeris of sunriset_ephemeris_init(), and the grid is cut in tiles
+of RASTER_ROWS rows which the worker threads take in turn from a shared
+counter.  Each worker writes its cells straight into the memory mapped
+output file, so there is no copying and no ordering to do.
+
+Released to the public domain
+
+ */
+#include "config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "raster.h"
+#include "sunriset.h"
+
+/* Rows per tile, the unit of work of a thread */
+#define RASTER_ROWS  8
+
+struct raster {
+	struct raster_header *hdr;
+	struct sunriset_ephemeris eph;
+	void    *band[3];	/* Rise, set, day length */
+	size_t   rows;		/* Next tile, shared by the workers */
+};
+
+static void cell(struct raster *r, size_t i, double lon, double lat)
+{
+	double rise, set, len;
+	int rc;
+
+	rc = sunriset_ephemeris_eval(&r->eph, lon, lat, -35.0 / 60.0, 1, &rise, &set);
+	len = rc ? (rc > 0 ? 24.0 : 0.0) : set - rise;
+
+	if (r->hdr->type == RASTER_FLOAT32) {
+		float *b0 = r->band[0], *b1 = r->band[1], *b2 = r->band[2];
+
+		b0[i] = rc ? NAN : (float)rise;
+		b1[i] = rc ? NAN : (float)set;
+		b2[i] = (float)len;
+	} else {
+		int16_t *b0 = r->band[0], *b1 = r->band[1], *b2 = r->band[2];
+
+		b0[i] = rc ? RASTER_NONE : (int16_t)lround(rise * 60.0);
+		b1[i] = rc ? RASTER_NONE : (int16_t)lround(set * 60.0);
+		b2[i] = (int16_t)lround(len * 60.0);
+	}
+}
+
+static void *worker(void *arg)
+{
+	struct raster *r = arg;
+	size_t width = r->hdr->width, height = r->hdr->height;
+
+	while (1) {
+		size_t row, end;
+
+		row = __atomic_fetch_add(&r->rows, RASTER_ROWS, __ATOMIC_RELAXED);
+		if (row >= height)
+			break;
+
+		end = row + RASTER_ROWS < height ? row + RASTER_ROWS : height;
+		for (; row < end; row++) {
+			double lat = r->hdr->lat0 - row * r->hdr->res;
+			size_t col;
+
+			for (col = 0; col < width; col++)
+				cell(r, row * width + col, r->hdr->lon0 + col * r->hdr->res, lat);
+		}
+	}
+
+	return NULL;
+}
+
+int raster_run(const char *file, int year, int month, int day, double res,
+	       int type, int threads)
+{
+	struct timespec t0, t1;
+	struct raster r;
+	pthread_t *id;
+	size_t width, height, cells, size;
+	double sec;
+	void *map;
+	int fd, i;
+
+	/* Whole cells from pole to pole, and so also around the globe */
+	if (res <= 0.0 || res > 90.0 || fabs(180.0 / res - lround(180.0 / res)) > 1e-6) {
+		fprintf(stderr, "Invalid grid resolution %g, must divide 180 degrees\n", res);
+		return 1;
+	}
+
+	width  = (size_t)lround(360.0 / res);
+	height = (size_t)lround(180.0 / res);
+	cells  = width * height;
+	size   = sizeof(struct raster_header) +
+		 3 * cells * (type == RASTER_FLOAT32 ? sizeof(float) : sizeof(int16_t));
+
+	if (threads <= 0)
+		threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads < 1)
+		threads = 1;
+
+	fd = open(file, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		fprintf(stderr, "Cannot open %s: %s\n", file, strerror(errno));
+		return 1;
+	}
+	if (ftruncate(fd, size)) {
+		fprintf(stderr, "Cannot size %s: %s\n", file, strerror(errno));
+		close(fd);
+		return 1;
+	}
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		fprintf(stderr, "Cannot map %s: %s\n", file, strerror(errno));
+		return 1;
+	}
+
+	memset(&r, 0, sizeof(r));
+	r.hdr = map;
+	memcpy(r.hdr->magic, RASTER_MAGIC, sizeof(r.hdr->magic));
+	r.hdr->version = RASTER_VERSION;
+	r.hdr->type    = type;
+	r.hdr->width   = width;
+	r.hdr->height  = height;
+	r.hdr->bands   = 3;
+	r.hdr->year    = year;
+	r.hdr->month   = month;
+	r.hdr->day     = day;
+	r.hdr->res     = 180.0 / height;
+	r.hdr->lon0    = -180.0 + r.hdr->res / 2.0;
+	r.hdr->lat0    =   90.0 - r.hdr->res / 2.0;
+
+	r.band[0] = r.hdr + 1;
+	for (i = 1; i < 3; i++)
+		r.band[i] = (char *)r.band[i - 1] +
+			cells * (type == RASTER_FLOAT32 ? sizeof(float) : sizeof(int16_t));
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	sunriset_ephemeris_init(&r.eph, year, month, day);
+
+	id = calloc(threads, sizeof(*id));
+	if (!id) {
+		munmap(map, size);
+		return 1;
+	}
+	for (i = 0; i < threads; i++) {
+		if (pthread_create(&id[i], NULL, worker, &r)) {
+			threads = i;
+			break;
+		}
+	}
+	if (!threads)
+		worker(&r);
+	for (i = 0; i < threads; i++)
+		pthread_join(id[i], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	free(id);
+
+	munmap(map, size);
+
+	sec = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	if (!threads)
+		threads = 1;
+	fprintf(stderr, "%zu x %zu cells in %.3f s, %.0f cells/sec, %d thread%s, %.0f cells/sec per thread\n",
+		width, height, sec, sec > 0.0 ? cells / sec : 0.0, threads, threads > 1 ? "s" : "",
+		sec > 0.0 ? cells / sec / threads : 0.0);
+
+	return 0;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,48 @@
+/*
+
+Global raster of sunrise, sunset and day length
+
+Released to the public domain
+
+ */
+#ifndef SUN_RASTER_H_
+#define SUN_RASTER_H_
+
+#include <stdint.h>
+
+#define RASTER_MAGIC    "SUNRAST"
+#define RASTER_VERSION  1
+
+/* Cell types */
+#define RASTER_FLOAT32  0	/* Hours UT, NaN for no rise or set */
+#define RASTER_INT16    1	/* Minutes UT, RASTER_NONE for no rise or set */
+
+#define RASTER_NONE     INT16_MIN
+
+/*
+ * File header, 64 bytes, followed by the bands rise, set and day length,
+ * each width x height cells, north to south and west to east.  lon0 and
+ * lat0 are the center of the first cell, north-west.
+ */
+struct raster_header {
+	char     magic[8];
+	uint32_t version;
+	uint32_t type;
+	uint32_t width, height;
+	uint32_t bands;
+	int32_t  year, month, day;
+	double   lon0, lat0;
+	double   res;		/* Degrees per cell */
+};
+
+int raster_run(const char *file, int year, int month, int day, double res,
+	       int type, int threads);
+
+#endif /* SUN_RASTER_H_ */
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,80 @@
+/*
+
+Instants of the equinoxes and solstices
+
+The seasons start when the Sun's apparent ecliptic longitude is 0, 90,
+180 or 270 degrees.  That is found by Newton's method on the longitude
+of sunpos(), whose rate follows from the same orbital elements: the
+mean anomaly advances 0.9856002585 degrees a day, the true anomaly
+faster by (1 + e cos v)^2 / (1 - e^2)^1.5, and the perihelion another
+4.70935E-5 degrees a day.  Starting from the mean date, three steps
+converge, less the aberration of light, -20.4898 arcsec / r, since
+sunpos() gives where the Sun is rather than where it is seen.
+
+That instant is only as good as sunpos(), a few minutes, as it leaves
+out the pull of the Moon and the planets.  Two more Newton steps, with
+the same rate but the apparent longitude of sun_longitude_precise(),
+bring it to within half a minute: its truncated VSOP87 series is good
+to about an arc second, some 25 seconds of the Sun's motion.  Meeus'
+example, the June solstice of 1962 at 21:25:08 TD, comes out at
+21:24:38.  The orbital elements run on terrestrial time, so Delta T,
+from sunriset_delta_t(), is then taken off to get UTC.  A century of
+seasons takes a few milliseconds.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+/* Julian day of 2000 Jan 0.0, i.e. d == 0 */
+#define JD_2000_JAN_0  2451543.5
+
+/* Longitude of the Sun at d, terrestrial time, and its rate per day */
+static double longitude(double d, double *rate)
+{
+	double lon, r, w, e, v;
+
+	sunpos(d, &lon, &r);
+
+	/* As in sunpos() */
+	w = 282.9404 + 4.70935E-5 * d;
+	e = 0.016709 - 1.151E-9 * d;
+	v = lon - w;
+
+	*rate = 0.9856002585 * pow(1.0 + e * cosd(v), 2.0) / pow(1.0 - e * e, 1.5) + 4.70935E-5;
+
+	return lon - 20.4898 / 3600.0 / r;
+}
+
+time_t sunriset_season( int year, int season )
+{
+	double d, rate, target, dt;
+	int i;
+
+	if (season < SUNRISET_MARCH_EQUINOX || season > SUNRISET_DECEMBER_SOLSTICE)
+		return (time_t)-1;
+
+	/* Mean dates, around March 20, June 21, September 22 and December 21 */
+	target = season * 90.0;
+	d = days_since_2000_Jan_0(year, 3, 20) + season * 365.2422 / 4.0;
+
+	for (i = 0; i < 3; i++)
+		d += rev180(target - longitude(d, &rate)) / rate;
+	for (i = 0; i < 2; i++)
+		d += rev180(target - sun_longitude_precise(JD_2000_JAN_0 + d, 0.0)) / rate;
+
+	/* Terrestrial time to UTC */
+	dt = sunriset_delta_t(year + (season * 3.0 + 2.5) / 12.0);
+	d -= dt / 86400.0;
+
+	return (time_t)floor((d + 10956.0) * 86400.0 + 0.5);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -0,0 +1,638 @@
+/*
+
+High precision tier for SUNRISET, after NREL's Solar Position Algorithm
+
+Reda, I. and Andreas, A., "Solar Position Algorithm for Solar Radiation
+Applications", NREL/TP-560-34302, 2003 (revised 2008).  The Earth's
+heliocentric position uses the same truncated VSOP87 series as SPA, the
+nutation the full 63 term IAU 1980 series of its table A4.3, and Delta
+T, the difference between terrestrial and universal time, is from the
+Espenak & Meeus polynomials.  The report's example, 2003-10-17 19:30:30
+UT at Golden, Colorado, is reproduced to 5E-7 degrees in azimuth and
+zenith angle.  Accuracy is about 0.0003 degrees in position, the limit
+of the truncated series, well below one second in event time, at a cost
+of some four hundred transcendental calls per position; only callers
+asking for the precise tier pay for it.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+#define NELEMS(array) (sizeof(array) / sizeof(array[0]))
+
+/* Julian day of 2000 Jan 0.0 UT, i.e. d == 0 */
+#define JD_2000_JAN_0  2451543.5
+
+struct term {
+	double a, b, c;
+};
+
+static const struct term L0[] = {
+	{ 175347046.0, 0, 0 },
+	{ 3341656.0, 4.6692568, 6283.07585 },
+	{ 34894.0, 4.6261, 12566.1517 },
+	{ 3497.0, 2.7441, 5753.3849 },
+	{ 3418.0, 2.8289, 3.5231 },
+	{ 3136.0, 3.6277, 77713.7715 },
+	{ 2676.0, 4.4181, 7860.4194 },
+	{ 2343.0, 6.1352, 3930.2097 },
+	{ 1324.0, 0.7425, 11506.7698 },
+	{ 1273.0, 2.0371, 529.691 },
+	{ 1199.0, 1.1096, 1577.3435 },
+	{ 990, 5.233, 5884.927 },
+	{ 902, 2.045, 26.298 },
+	{ 857, 3.508, 398.149 },
+	{ 780, 1.179, 5223.694 },
+	{ 753, 2.533, 5507.553 },
+	{ 505, 4.583, 18849.228 },
+	{ 492, 4.205, 775.523 },
+	{ 357, 2.92, 0.067 },
+	{ 317, 5.849, 11790.629 },
+	{ 284, 1.899, 796.298 },
+	{ 271, 0.315, 10977.079 },
+	{ 243, 0.345, 5486.778 },
+	{ 206, 4.806, 2544.314 },
+	{ 205, 1.869, 5573.143 },
+	{ 202, 2.458, 6069.777 },
+	{ 156, 0.833, 213.299 },
+	{ 132, 3.411, 2942.463 },
+	{ 126, 1.083, 20.775 },
+	{ 115, 0.645, 0.98 },
+	{ 103, 0.636, 4694.003 },
+	{ 102, 0.976, 15720.839 },
+	{ 102, 4.267, 7.114 },
+	{ 99, 6.21, 2146.17 },
+	{ 98, 0.68, 155.42 },
+	{ 86, 5.98, 161000.69 },
+	{ 85, 1.3, 6275.96 },
+	{ 85, 3.67, 71430.7 },
+	{ 80, 1.81, 17260.15 },
+	{ 79, 3.04, 12036.46 },
+	{ 75, 1.76, 5088.63 },
+	{ 74, 3.5, 3154.69 },
+	{ 74, 4.68, 801.82 },
+	{ 70, 0.83, 9437.76 },
+	{ 62, 3.98, 8827.39 },
+	{ 61, 1.82, 7084.9 },
+	{ 57, 2.78, 6286.6 },
+	{ 56, 4.39, 14143.5 },
+	{ 56, 3.47, 6279.55 },
+	{ 52, 0.19, 12139.55 },
+	{ 52, 1.33, 1748.02 },
+	{ 51, 0.28, 5856.48 },
+	{ 49, 0.49, 1194.45 },
+	{ 41, 5.37, 8429.24 },
+	{ 41, 2.4, 19651.05 },
+	{ 39, 6.17, 10447.39 },
+	{ 37, 6.04, 10213.29 },
+	{ 37, 2.57, 1059.38 },
+	{ 36, 1.71, 2352.87 },
+	{ 36, 1.78, 6812.77 },
+	{ 33, 0.59, 17789.85 },
+	{ 30, 0.44, 83996.85 },
+	{ 30, 2.74, 1349.87 },
+	{ 25, 3.16, 4690.48 },
+};
+
+static const struct term L1[] = {
+	{ 628331966747.0, 0, 0 },
+	{ 206059.0, 2.678235, 6283.07585 },
+	{ 4303.0, 2.6351, 12566.1517 },
+	{ 425.0, 1.59, 3.523 },
+	{ 119.0, 5.796, 26.298 },
+	{ 109.0, 2.966, 1577.344 },
+	{ 93, 2.59, 18849.23 },
+	{ 72, 1.14, 529.69 },
+	{ 68, 1.87, 398.15 },
+	{ 67, 4.41, 5507.55 },
+	{ 59, 2.89, 5223.69 },
+	{ 56, 2.17, 155.42 },
+	{ 45, 0.4, 796.3 },
+	{ 36, 0.47, 775.52 },
+	{ 29, 2.65, 7.11 },
+	{ 21, 5.34, 0.98 },
+	{ 19, 1.85, 5486.78 },
+	{ 19, 4.97, 213.3 },
+	{ 17, 2.99, 6275.96 },
+	{ 16, 0.03, 2544.31 },
+	{ 16, 1.43, 2146.17 },
+	{ 15, 1.21, 10977.08 },
+	{ 12, 2.83, 1748.02 },
+	{ 12, 3.26, 5088.63 },
+	{ 12, 5.27, 1194.45 },
+	{ 12, 2.08, 4694 },
+	{ 11, 0.77, 553.57 },
+	{ 10, 1.3, 6286.6 },
+	{ 10, 4.24, 1349.87 },
+	{ 9, 2.7, 242.73 },
+	{ 9, 5.64, 951.72 },
+	{ 8, 5.3, 2352.87 },
+	{ 6, 2.65, 9437.76 },
+	{ 6, 4.67, 4690.48 },
+};
+
+static const struct term L2[] = {
+	{ 52919.0, 0, 0 },
+	{ 8720.0, 1.0721, 6283.0758 },
+	{ 309.0, 0.867, 12566.152 },
+	{ 27, 0.05, 3.52 },
+	{ 16, 5.19, 26.3 },
+	{ 16, 3.68, 155.42 },
+	{ 10, 0.76, 18849.23 },
+	{ 9, 2.06, 77713.77 },
+	{ 7, 0.83, 775.52 },
+	{ 5, 4.66, 1577.34 },
+	{ 4, 1.03, 7.11 },
+	{ 4, 3.44, 5573.14 },
+	{ 3, 5.14, 796.3 },
+	{ 3, 6.05, 5507.55 },
+	{ 3, 1.19, 242.73 },
+	{ 3, 6.12, 529.69 },
+	{ 3, 0.31, 398.15 },
+	{ 3, 2.28, 553.57 },
+	{ 2, 4.38, 5223.69 },
+	{ 2, 3.75, 0.98 },
+};
+
+static const struct term L3[] = {
+	{ 289.0, 5.844, 6283.076 },
+	{ 35, 0, 0 },
+	{ 17, 5.49, 12566.15 },
+	{ 3, 5.2, 155.42 },
+	{ 1, 4.72, 3.52 },
+	{ 1, 5.3, 18849.23 },
+	{ 1, 5.97, 242.73 },
+};
+
+static const struct term L4[] = {
+	{ 114.0, 3.142, 0 },
+	{ 8, 4.13, 6283.08 },
+	{ 1, 3.84, 12566.15 },
+};
+
+static const struct term L5[] = {
+	{ 1, 3.14, 0 },
+};
+
+static const struct term B0[] = {
+	{ 280.0, 3.199, 84334.662 },
+	{ 102.0, 5.422, 5507.553 },
+	{ 80, 3.88, 5223.69 },
+	{ 44, 3.7, 2352.87 },
+	{ 32, 4, 1577.34 },
+};
+
+static const struct term B1[] = {
+	{ 9, 3.9, 5507.55 },
+	{ 6, 1.73, 5223.69 },
+};
+
+static const struct term R0[] = {
+	{ 100013989.0, 0, 0 },
+	{ 1670700.0, 3.0984635, 6283.07585 },
+	{ 13956.0, 3.05525, 12566.1517 },
+	{ 3084.0, 5.1985, 77713.7715 },
+	{ 1628.0, 1.1739, 5753.3849 },
+	{ 1576.0, 2.8469, 7860.4194 },
+	{ 925.0, 5.453, 11506.77 },
+	{ 542.0, 4.564, 3930.21 },
+	{ 472.0, 3.661, 5884.927 },
+	{ 346.0, 0.964, 5507.553 },
+	{ 329.0, 5.9, 5223.694 },
+	{ 307.0, 0.299, 5573.143 },
+	{ 243.0, 4.273, 11790.629 },
+	{ 212.0, 5.847, 1577.344 },
+	{ 186.0, 5.022, 10977.079 },
+	{ 175.0, 3.012, 18849.228 },
+	{ 110.0, 5.055, 5486.778 },
+	{ 98, 0.89, 6069.78 },
+	{ 86, 5.69, 15720.84 },
+	{ 86, 1.27, 161000.69 },
+	{ 65, 0.27, 17260.15 },
+	{ 63, 0.92, 529.69 },
+	{ 57, 2.01, 83996.85 },
+	{ 56, 5.24, 71430.7 },
+	{ 49, 3.25, 2544.31 },
+	{ 47, 2.58, 775.52 },
+	{ 45, 5.54, 9437.76 },
+	{ 43, 6.01, 6275.96 },
+	{ 39, 5.36, 4694 },
+	{ 38, 2.39, 8827.39 },
+	{ 37, 0.83, 19651.05 },
+	{ 37, 4.9, 12139.55 },
+	{ 36, 1.67, 12036.46 },
+	{ 35, 1.84, 2942.46 },
+	{ 33, 0.24, 7084.9 },
+	{ 32, 0.18, 5088.63 },
+	{ 32, 1.78, 398.15 },
+	{ 28, 1.21, 6286.6 },
+	{ 28, 1.9, 6279.55 },
+	{ 26, 4.59, 10447.39 },
+};
+
+static const struct term R1[] = {
+	{ 103019.0, 1.10749, 6283.07585 },
+	{ 1721.0, 1.0644, 12566.1517 },
+	{ 702.0, 3.142, 0 },
+	{ 32, 1.02, 18849.23 },
+	{ 31, 2.84, 5507.55 },
+	{ 25, 1.32, 5223.69 },
+	{ 18, 1.42, 1577.34 },
+	{ 10, 5.91, 10977.08 },
+	{ 9, 1.42, 6275.96 },
+	{ 9, 0.27, 5486.78 },
+};
+
+static const struct term R2[] = {
+	{ 4359.0, 5.7846, 6283.0758 },
+	{ 124.0, 5.579, 12566.152 },
+	{ 12, 3.14, 0 },
+	{ 9, 3.63, 77713.77 },
+	{ 6, 1.87, 5573.14 },
+	{ 3, 5.47, 18849.23 },
+};
+
+static const struct term R3[] = {
+	{ 145.0, 4.273, 6283.076 },
+	{ 7, 3.92, 12566.15 },
+};
+
+static const struct term R4[] = {
+	{ 4, 2.56, 6283.08 },
+};
+
+/*
+ * Nutation in longitude and obliquity, IAU 1980 as in SPA table A4.3:
+ * multiples of the arguments D, M, M', F and omega, and the sine and
+ * cosine coefficients, each a + b jce, in units of 0.0001 arcsec
+ */
+struct nutation {
+	signed char y[5];
+	double      a, b, c, d;
+};
+
+static const struct nutation N[] = {
+	{ {  0,  0,  0,  0,  1 }, -171996, -174.2, 92025, 8.9 },
+	{ { -2,  0,  0,  2,  2 }, -13187, -1.6, 5736, -3.1 },
+	{ {  0,  0,  0,  2,  2 }, -2274, -0.2, 977, -0.5 },
+	{ {  0,  0,  0,  0,  2 }, 2062, 0.2, -895, 0.5 },
+	{ {  0,  1,  0,  0,  0 }, 1426, -3.4, 54, -0.1 },
+	{ {  0,  0,  1,  0,  0 }, 712, 0.1, -7, 0 },
+	{ { -2,  1,  0,  2,  2 }, -517, 1.2, 224, -0.6 },
+	{ {  0,  0,  0,  2,  1 }, -386, -0.4, 200, 0 },
+	{ {  0,  0,  1,  2,  2 }, -301, 0, 129, -0.1 },
+	{ { -2, -1,  0,  2,  2 }, 217, -0.5, -95, 0.3 },
+	{ { -2,  0,  1,  0,  0 }, -158, 0, 0, 0 },
+	{ { -2,  0,  0,  2,  1 }, 129, 0.1, -70, 0 },
+	{ {  0,  0, -1,  2,  2 }, 123, 0, -53, 0 },
+	{ {  2,  0,  0,  0,  0 }, 63, 0, 0, 0 },
+	{ {  0,  0,  1,  0,  1 }, 63, 0.1, -33, 0 },
+	{ {  2,  0, -1,  2,  2 }, -59, 0, 26, 0 },
+	{ {  0,  0, -1,  0,  1 }, -58, -0.1, 32, 0 },
+	{ {  0,  0,  1,  2,  1 }, -51, 0, 27, 0 },
+	{ { -2,  0,  2,  0,  0 }, 48, 0, 0, 0 },
+	{ {  0,  0, -2,  2,  1 }, 46, 0, -24, 0 },
+	{ {  2,  0,  0,  2,  2 }, -38, 0, 16, 0 },
+	{ {  0,  0,  2,  2,  2 }, -31, 0, 13, 0 },
+	{ {  0,  0,  2,  0,  0 }, 29, 0, 0, 0 },
+	{ { -2,  0,  1,  2,  2 }, 29, 0, -12, 0 },
+	{ {  0,  0,  0,  2,  0 }, 26, 0, 0, 0 },
+	{ { -2,  0,  0,  2,  0 }, -22, 0, 0, 0 },
+	{ {  0,  0, -1,  2,  1 }, 21, 0, -10, 0 },
+	{ {  0,  2,  0,  0,  0 }, 17, -0.1, 0, 0 },
+	{ {  2,  0, -1,  0,  1 }, 16, 0, -8, 0 },
+	{ { -2,  2,  0,  2,  2 }, -16, 0.1, 7, 0 },
+	{ {  0,  1,  0,  0,  1 }, -15, 0, 9, 0 },
+	{ { -2,  0,  1,  0,  1 }, -13, 0, 7, 0 },
+	{ {  0, -1,  0,  0,  1 }, -12, 0, 6, 0 },
+	{ {  0,  0,  2, -2,  0 }, 11, 0, 0, 0 },
+	{ {  2,  0, -1,  2,  1 }, -10, 0, 5, 0 },
+	{ {  2,  0,  1,  2,  2 }, -8, 0, 3, 0 },
+	{ {  0,  1,  0,  2,  2 }, 7, 0, -3, 0 },
+	{ { -2,  1,  1,  0,  0 }, -7, 0, 0, 0 },
+	{ {  0, -1,  0,  2,  2 }, -7, 0, 3, 0 },
+	{ {  2,  0,  0,  2,  1 }, -7, 0, 3, 0 },
+	{ {  2,  0,  1,  0,  0 }, 6, 0, 0, 0 },
+	{ { -2,  0,  2,  2,  2 }, 6, 0, -3, 0 },
+	{ { -2,  0,  1,  2,  1 }, 6, 0, -3, 0 },
+	{ {  2,  0, -2,  0,  1 }, -6, 0, 3, 0 },
+	{ {  2,  0,  0,  0,  1 }, -6, 0, 3, 0 },
+	{ {  0, -1,  1,  0,  0 }, 5, 0, 0, 0 },
+	{ { -2, -1,  0,  2,  1 }, -5, 0, 3, 0 },
+	{ { -2,  0,  0,  0,  1 }, -5, 0, 3, 0 },
+	{ {  0,  0,  2,  2,  1 }, -5, 0, 3, 0 },
+	{ { -2,  0,  2,  0,  1 }, 4, 0, 0, 0 },
+	{ { -2,  1,  0,  2,  1 }, 4, 0, 0, 0 },
+	{ {  0,  0,  1, -2,  0 }, 4, 0, 0, 0 },
+	{ { -1,  0,  1,  0,  0 }, -4, 0, 0, 0 },
+	{ { -2,  1,  0,  0,  0 }, -4, 0, 0, 0 },
+	{ {  1,  0,  0,  0,  0 }, -4, 0, 0, 0 },
+	{ {  0,  0,  1,  2,  0 }, 3, 0, 0, 0 },
+	{ {  0,  0, -2,  2,  2 }, -3, 0, 0, 0 },
+	{ { -1, -1,  1,  0,  0 }, -3, 0, 0, 0 },
+	{ {  0,  1,  1,  0,  0 }, -3, 0, 0, 0 },
+	{ {  0, -1,  1,  2,  2 }, -3, 0, 0, 0 },
+	{ {  2, -1, -1,  2,  2 }, -3, 0, 0, 0 },
+	{ {  0,  0,  3,  2,  2 }, -3, 0, 0, 0 },
+	{ {  2, -1,  0,  2,  2 }, -3, 0, 0, 0 },
+};
+
+#define SERIES(t) { t, NELEMS(t) }
+
+static const struct series {
+	const struct term *t;
+	size_t             n;
+} L[] = {
+	SERIES(L0), SERIES(L1), SERIES(L2), SERIES(L3), SERIES(L4), SERIES(L5)
+}, B[] = {
+	SERIES(B0), SERIES(B1)
+}, R[] = {
+	SERIES(R0), SERIES(R1), SERIES(R2), SERIES(R3), SERIES(R4)
+};
+
+/*
+ * Sum of periodic terms, as a polynomial in jme, result in 1E-8 units
+ */
+static double vsop(const struct series *s, size_t n, double jme)
+{
+	double sum = 0.0;
+	size_t i, j;
+
+	for (i = n; i-- > 0;) {
+		double x = 0.0;
+
+		for (j = 0; j < s[i].n; j++)
+			x += s[i].t[j].a * cos(s[i].t[j].b + s[i].t[j].c * jme);
+		sum = sum * jme + x;
+	}
+
+	return sum / 1e8;
+}
+
+double sunriset_delta_t( double year )
+{
+	double t, u;
+
+	if (year < 1800.0 || year >= 2150.0) {
+		u = (year - 1820.0) / 100.0;
+		return -20.0 + 32.0 * u * u;
+	}
+	if (year < 1860.0) {
+		t = year - 1800.0;
+		return 13.72 + t * (-0.332447 + t * (0.0068612 + t * (0.0041116 +
+		       t * (-0.00037436 + t * (0.0000121272 + t * (-0.0000001699 +
+		       t * 0.000000000875))))));
+	}
+	if (year < 1900.0) {
+		t = year - 1860.0;
+		return 7.62 + t * (0.5737 + t * (-0.251754 + t * (0.01680668 +
+		       t * (-0.0004473624 + t / 233174.0))));
+	}
+	if (year < 1920.0) {
+		t = year - 1900.0;
+		return -2.79 + t * (1.494119 + t * (-0.0598939 + t * (0.0061966 +
+		       t * -0.000197)));
+	}
+	if (year < 1941.0) {
+		t = year - 1920.0;
+		return 21.20 + t * (0.84493 + t * (-0.076100 + t * 0.0020936));
+	}
+	if (year < 1961.0) {
+		t = year - 1950.0;
+		return 29.07 + t * (0.407 + t * (-1.0 / 233.0 + t / 2547.0));
+	}
+	if (year < 1986.0) {
+		t = year - 1975.0;
+		return 45.45 + t * (1.067 + t * (-1.0 / 260.0 - t / 718.0));
+	}
+	if (year < 2005.0) {
+		t = year - 2000.0;
+		return 63.86 + t * (0.3345 + t * (-0.060374 + t * (0.0017275 +
+		       t * (0.000651814 + t * 0.00002373599))));
+	}
+	if (year < 2050.0) {
+		t = year - 2000.0;
+		return 62.92 + t * (0.32217 + t * 0.005589);
+	}
+
+	u = (year - 1820.0) / 100.0;
+	return -20.0 + 32.0 * u * u - 0.5628 * (2150.0 - year);
+}
+
+/*
+ * Apparent ecliptic longitude and latitude of the Sun, the nutation in
+ * longitude, the true obliquity of the ecliptic and the radius vector,
+ * all in degrees or AU, at Julian ephemeris day jde.
+ */
+static void ecliptic(double jde, double *lambda, double *beta, double *dpsi,
+		     double *eps, double *r)
+{
+	double jce, jme, l, b, theta, x[5], deps, u;
+	size_t i, j;
+
+	jce = (jde - 2451545.0) / 36525.0;
+	jme = jce / 10.0;
+
+	/* 3.2 Earth heliocentric longitude, latitude and radius vector */
+	l  = revolution(RADEG * vsop(L, NELEMS(L), jme));
+	b  = RADEG * vsop(B, NELEMS(B), jme);
+	*r = vsop(R, NELEMS(R), jme);
+
+	/* 3.3 Geocentric longitude and latitude */
+	theta = revolution(l + 180.0);
+	*beta = -b;
+
+	/* 3.4 Nutation in longitude and obliquity */
+	x[0] = 297.85036 + jce * (445267.111480 + jce * (-0.0019142 + jce / 189474.0));
+	x[1] = 357.52772 + jce * (35999.050340 + jce * (-0.0001603 - jce / 300000.0));
+	x[2] = 134.96298 + jce * (477198.867398 + jce * (0.0086972 + jce / 56250.0));
+	x[3] = 93.27191 + jce * (483202.017538 + jce * (-0.0036825 + jce / 327270.0));
+	x[4] = 125.04452 + jce * (-1934.136261 + jce * (0.0020708 + jce / 450000.0));
+	*dpsi = deps = 0.0;
+	for (i = 0; i < NELEMS(N); i++) {
+		double arg = 0.0;
+
+		for (j = 0; j < 5; j++)
+			arg += N[i].y[j] * x[j];
+		*dpsi += (N[i].a + N[i].b * jce) * sind(arg);
+		deps  += (N[i].c + N[i].d * jce) * cosd(arg);
+	}
+	*dpsi /= 36000000.0;
+	deps  /= 36000000.0;
+
+	/* 3.5 True obliquity of the ecliptic */
+	u    = jme / 10.0;
+	*eps = 84381.448 + u * (-4680.93 + u * (-1.55 + u * (1999.25 + u * (-51.38 +
+	       u * (-249.67 + u * (-39.05 + u * (7.12 + u * (27.87 + u * (5.79 +
+	       u * 2.45)))))))));
+	*eps = *eps / 3600.0 + deps;
+
+	/* 3.6-3.7 Aberration correction and apparent longitude */
+	*lambda = theta + *dpsi - 20.4898 / (3600.0 * *r);
+}
+
+/*
+ * Geocentric apparent right ascension and declination, apparent
+ * sidereal time at Greenwich and radius vector, all in degrees or AU,
+ * at Julian day jd (UT).  Steps as numbered in the NREL report.
+ */
+static void equatorial(double jd, double delta_t, double *alpha, double *delta,
+		       double *nu, double *r)
+{
+	double jc, lambda, beta, dpsi, eps, x, nu0;
+
+	ecliptic(jd + delta_t / 86400.0, &lambda, &beta, &dpsi, &eps, r);
+	jc = (jd - 2451545.0) / 36525.0;
+
+	/* 3.8 Apparent sidereal time at Greenwich */
+	nu0 = revolution(280.46061837 + 360.98564736629 * (jd - 2451545.0) +
+			 jc * jc * (0.000387933 - jc / 38710000.0));
+	*nu = nu0 + dpsi * cosd(eps);
+
+	/* 3.9-3.10 Geocentric right ascension and declination */
+	x = sind(lambda) * cosd(eps) - tand(beta) * sind(eps);
+	*alpha = revolution(atan2d(x, cosd(lambda)));
+	*delta = asind(sind(beta) * cosd(eps) + cosd(beta) * sind(eps) * sind(lambda));
+}
+
+double sun_longitude_precise( double jd, double delta_t )
+{
+	double lambda, beta, dpsi, eps, r;
+
+	ecliptic(jd + delta_t / 86400.0, &lambda, &beta, &dpsi, &eps, &r);
+
+	return revolution(lambda);
+}
+
+void sun_position_precise( double jd, double delta_t, double lon, double lat,
+			   double elevation, double pressure, double temperature,
+			   double *azimuth, double *zenith )
+{
+	double alpha, delta, nu, r, h, xi, u, x, y, dalpha, delta1, h1, e0, e, de;
+
+	equatorial(jd, delta_t, &alpha, &delta, &nu, &r);
+
+	/* 3.11 Observer local hour angle */
+	h = revolution(nu + lon - alpha);
+
+	/* 3.12 Topocentric right ascension and declination, parallax */
+	xi = 8.794 / (3600.0 * r);
+	u  = atand(0.99664719 * tand(lat));
+	x  = cosd(u) + elevation / 6378140.0 * cosd(lat);
+	y  = 0.99664719 * sind(u) + elevation / 6378140.0 * sind(lat);
+	dalpha = atan2d(-x * sind(xi) * sind(h), cosd(delta) - x * sind(xi) * cosd(h));
+	delta1 = atan2d((sind(delta) - y * sind(xi)) * cosd(dalpha),
+			cosd(delta) - x * sind(xi) * cosd(h));
+
+	/* 3.13 Topocentric local hour angle */
+	h1 = h - dalpha;
+
+	/* 3.14 Topocentric elevation, with refraction if the Sun is up */
+	e0 = asind(sind(lat) * sind(delta1) + cosd(lat) * cosd(delta1) * cosd(h1));
+	de = 0.0;
+	if (e0 >= -(0.26667 + 0.5667))
+		de = pressure / 1010.0 * 283.0 / (273.0 + temperature) *
+			1.02 / (60.0 * tand(e0 + 10.3 / (e0 + 5.11)));
+	e = e0 + de;
+
+	/* 3.15 Topocentric zenith and azimuth, the latter from north */
+	*zenith  = 90.0 - e;
+	*azimuth = revolution(180.0 + atan2d(sind(h1), cosd(h1) * sind(lat) -
+					     tand(delta1) * cosd(lat)));
+}
+
+/*
+ * Local hour angle of the Sun, minus target, in degrees -180..180 at
+ * hour ut of day number d, also returns declination and radius vector.
+ */
+static double hour_angle(double d, double ut, double lon, double delta_t,
+			 double *delta, double *r)
+{
+	double alpha, nu;
+
+	equatorial(JD_2000_JAN_0 + d + ut / 24.0, delta_t, &alpha, delta, &nu, r);
+
+	return rev180(nu + lon - alpha);
+}
+
+int __sunriset_precise__( int year, int month, int day, double lon, double lat,
+			  double altit, int upper_limb, double *trise, double *tset )
+{
+	double d, dt, tsouth, t, delta, r, cost, ut;
+	int i, rc = 0;
+
+	d  = days_since_2000_Jan_0(year, month, day);
+	dt = sunriset_delta_t(year + (month - 0.5) / 12.0);
+
+	/* Transit, the Sun's hour angle changes ~15 degrees per hour */
+	tsouth = 12.0 - lon / 15.0;
+	for (i = 0; i < 5; i++) {
+		double step = hour_angle(d, tsouth, lon, dt, &delta, &r) / 15.0;
+
+		tsouth -= step;
+		if (fabs(step) < 1e-7)
+			break;
+	}
+
+	/* Apparent radius, semidiameter 959.63 arcsec at 1 AU */
+	if (upper_limb)
+		altit -= 959.63 / 3600.0 / r;
+
+	cost = (sind(altit) - sind(lat) * sind(delta)) / (cosd(lat) * cosd(delta));
+	if (cost >= 1.0) {
+		*trise = *tset = tsouth;
+		return -1;
+	}
+	if (cost <= -1.0) {
+		*trise = tsouth - 12.0;
+		*tset  = tsouth + 12.0;
+		return +1;
+	}
+
+	/* Rise and set, re-evaluate the Sun's position at each instant */
+	for (i = -1; i <= 1; i += 2) {
+		int n;
+
+		t  = acosd(cost);
+		ut = tsouth + i * t / 15.0;
+		for (n = 0; n < 10; n++) {
+			double h, step, c;
+
+			h = hour_angle(d, ut, lon, dt, &delta, &r);
+			c = (sind(altit) - sind(lat) * sind(delta)) / (cosd(lat) * cosd(delta));
+			if (c >= 1.0 || c <= -1.0)
+				break;
+
+			step = rev180(h - i * acosd(c)) / 15.0;
+			ut  -= step;
+			if (fabs(step) < 1e-7)
+				break;
+		}
+
+		if (i < 0)
+			*trise = ut;
+		else
+			*tset = ut;
+	}
+
+	return rc;
+}
+
+int __sunriset_tier__( int tier, int year, int month, int day, double lon, double lat,
+		       double altit, int upper_limb, double *trise, double *tset )
+{
+	if (tier == SUNRISET_PRECISE)
+		return __sunriset_precise__(year, month, day, lon, lat, altit, upper_limb, trise, tset);
+
+	return __sunriset__(year, month, day, lon, lat, altit, upper_limb, trise, tset);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -9,19 +9,26 @@ Released to the public domain by Joachim Nilsson, December 2017
  */
 #include "config.h"
 
+#include <errno.h>
 #include <getopt.h>
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
-
-#include "tzalias.h"
+#include <sys/stat.h>
+#ifdef HAVE_SYS_TIMERFD_H
+#include <sys/timerfd.h>
+#endif
+
+#include "batch.h"
+#include "daemon.h"
+#include "raster.h"
 #include "sunriset.h"
 
 #define TIMEZONE "/etc/timezone"
-#define ZONETAB  "/usr/share/zoneinfo/zone.tab"
 
 /* From The Practice of Programming, by Kernighan and Pike */
 #define NELEMS(array) (sizeof(array) / sizeof(array[0]))
@@ -33,22 +40,32 @@ static time_t offset = 0;
 static int  utc = 0;
 static int  verbose = 1;
 static int  do_wait = 0;
+static int  nearest = 0;
+static int  step = 60;
+static int  use_cache = 0;
+static char *cachedir = NULL;
+static sunriset_cache *cache = NULL;
+static sunriset_tz *zone = NULL;
 extern char *__progname;
 
-static time_t timediff(void)
+/*
+ * UT offset in seconds at time t, from the zone's TZif transitions, so
+ * each event gets the offset in effect on its own date, not today's
+ */
+static long timediff(time_t t)
 {
-	static int done = 0;
-	static time_t diff;
-
-	if (done)
-		return diff;
+	if (utc)
+		return 0;
+	if (zone)
+		return sunriset_tz_offset(zone, t, NULL);
 
-//	tzset();
-//	diff = -timezone;
-	diff = tm->tm_gmtoff;
-	done = 1;
+	return tm->tm_gmtoff;
+}
 
-	return diff;
+/* Time of 0h UT of date, which event times in hours UT are relative to */
+static time_t midnight(int year, int month, int day)
+{
+	return ((time_t)days_since_2000_Jan_0(year, month, day) + 10956) * 86400;
 }
 
 /*
@@ -80,75 +97,144 @@ static time_t convert_offset(char *arg)
 	return val;
 }
 
-static void convert(double ut, int *h, int *m)
+static void convert(time_t day, double ut, int *h, int *m)
 {
-	*h = (int)floor(ut);
-	*m = (int)(60 * (ut - floor(ut)));
- 
-	*m += (timediff() % 3600)/60;
-	*h += timediff() / 3600;
+	long min;
+
+	min = (long)floor(ut * 60) + timediff(day + (time_t)(ut * 3600)) / 60;
+	*h = (int)floor(min / 60.0);
+	*m = (int)(min - *h * 60L);
 }
 
-static char *lctime_r(double ut, char *buf, size_t len)
+static char *lctime_r(time_t day, double ut, char *buf, size_t len)
 {
 	int h, m;
 
-	convert(ut, &h, &m);
-	snprintf(buf, len, "%02d:%02d", h, m);
+	/* Events near midnight may fall on the day before or after */
+	convert(day, ut, &h, &m);
+	snprintf(buf, len, "%02d:%02d", (h % 24 + 24) % 24, m);
 
 	return buf;
 }
 
-static char *lctime(double ut)
+static char *lctime(time_t day, double ut)
 {
 	static char buf[10];
 
-	return lctime_r(ut, buf, sizeof(buf));
+	return lctime_r(day, ut, buf, sizeof(buf));
+}
+
+/*
+ * Absolute deadline of the next sunrise/sunset with the offset, which
+ * above the polar circles may be months away.  After a clock step the
+ * search starts slack seconds back, so a small step across the event
+ * fires it rather than skipping to the next day.
+ */
+static time_t deadline(double lat, double lon, int rise, time_t slack)
+{
+	time_t then;
+
+	then = sunriset_next(time(NULL) - offset - slack, lon, lat, -35.0 / 60.0, 1, rise);
+	if (then == (time_t)-1)
+		return then;
+
+	return then + offset;
+}
+
+/*
+ * Sleep until the deadline on CLOCK_REALTIME, not for a number of
+ * seconds, so time spent suspended counts and there is no drift.  With
+ * a timerfd the kernel also cancels the wait when the clock is set, by
+ * NTP or by hand, and the deadline is then computed again.
+ */
+static int wait_until(double lat, double lon, int rise)
+{
+	struct timespec ts = { 0, 0 };
+	time_t then, sec;
+	int h, m, s;
+#ifdef TFD_TIMER_CANCEL_ON_SET
+	int fd;
+#endif
+
+	then = deadline(lat, lon, rise, 0);
+	if (then == (time_t)-1)
+		goto never;
+	sec = then - now;
+
+	/* Pretty printing */
+	h = sec / 60 / 60;
+	m = sec / 60 - h * 60;
+	s = sec - m * 60 - h * 60 * 60;
+	PRINTF("Sleeping %dh%dm%ds ...\n", h, m, s);
+	fflush(stdout);
+
+#ifdef TFD_TIMER_CANCEL_ON_SET
+	fd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+	while (fd >= 0) {
+		struct itimerspec its = { { 0, 0 }, { then, 0 } };
+		uint64_t expired;
+
+		if (timerfd_settime(fd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &its, NULL))
+			break;
+
+		if (read(fd, &expired, sizeof(expired)) == sizeof(expired)) {
+			close(fd);
+			return 0;
+		}
+
+		if (errno == ECANCELED) {
+			then = deadline(lat, lon, rise, 60);
+			if (then == (time_t)-1) {
+				close(fd);
+				goto never;
+			}
+			PRINTF("Clock changed, sleeping until %s", ctime(&then));
+			fflush(stdout);
+		} else if (errno != EINTR)
+			break;
+	}
+	if (fd >= 0)
+		close(fd);
+#endif
+
+	/* Fallback, still absolute but without noticing clock changes */
+	ts.tv_sec = then;
+	while (clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+
+	return 0;
+never:
+	fprintf(stderr, "The Sun does not %s here.\n", rise ? "rise" : "set");
+	return 1;
 }
 
 static int riset(int mode, double lat, double lon, int year, int month, int day)
 {
+	time_t date = midnight(year, month, day);
 	double rise, set;
 //	char bufr[10], bufs[10];
 
-	sun_rise_set(year, month, day, lon, lat, &rise, &set);
+	if (cache) {
+		struct sunriset_event ev[SUNRISET_CACHE_EVENTS];
+
+		sunriset_cache_get(cache, year, month, day, ev);
+		rise = ev[0].rise;
+		set  = ev[0].set;
+	} else
+		sun_rise_set(year, month, day, lon, lat, &rise, &set);
 
 	if (mode)
-		PRINTF("Sun rises %s", lctime(rise));
+		PRINTF("Sun rises %s", lctime(date, rise));
 	if (!mode)
-		PRINTF("Sun sets %s", lctime(set));
+		PRINTF("Sun sets %s", lctime(date, set));
 	if (mode == -1)
-		PRINTF(", sets %s", lctime(set));
+		PRINTF(", sets %s", lctime(date, set));
 	PRINTF(" %s\n", tm->tm_zone);
 //	printf("Sun rises %s, sets %s %s\n", lctime_r(rise, bufr, sizeof(bufr)),
 //	       lctime_r(set, bufs, sizeof(bufs)), tm->tm_zone);
 
-	if (do_wait > 0) {
-		int h, m, s;
-		time_t then, sec;
-
-		if (mode)
-			convert(rise, &h, &m);
-		else
-			convert(set, &h, &m);
-
-		/* Adjust for sunset/sunrise regardless of timezone */
-		h = h - tm->tm_hour;
-		if (h < 0)
-			h += 24;
-		m = m - tm->tm_min;
-		if (m < 0)
-			m += 60;
-		then = now + 3600 * h + 60 * m;
-		sec = then - now + offset;
-
-		/* Pretty printing */
-		h = sec / 60 / 60;
-		m = sec / 60 - h * 60;
-		s = sec - m * 60 - h * 60 * 60;
-		PRINTF("Sleeping %dh%dm%ds ...\n", h, m, s);
-		sleep(sec);
-	}
+	if (do_wait > 0)
+		return wait_until(lat, lon, mode != 0);
 
 	return 0;
 }
@@ -165,16 +251,39 @@ static int sunset(double lat, double lon, int year, int month, int day)
 
 static int all(double lat, double lon, int year, int month, int day)
 {
+	struct sunriset_event ev[] = {
+		{ .altit = -35.0 / 60.0, .upper_limb = 1 },	/* Rise/set */
+		{ .altit =  -6.0 },				/* Civil */
+		{ .altit = -12.0 },				/* Nautical */
+		{ .altit = -18.0 },				/* Astronomical */
+	};
+	const char *fmt[][3] = {
+		{ "Sun rises %s, sets %s %s\n",
+		  "Sun above horizon\n",
+		  "Sun below horizon\n" },
+		{ "Civil twilight starts %s, ends %s %s\n",
+		  "Never darker than civil twilight\n",
+		  "Never as bright as civil twilight\n" },
+		{ "Nautical twilight starts %s, ends %s %s\n",
+		  "Never darker than nautical twilight\n",
+		  "Never as bright as nautical twilight\n" },
+		{ "Astronomical twilight starts %s, ends %s %s\n",
+		  "Never darker than astronomical twilight\n",
+		  "Never as bright as astronomical twilight\n" },
+	};
+	time_t date = midnight(year, month, day);
 	double daylen, civlen, nautlen, astrlen;
-	double rise, set, civ_start, civ_end, naut_start, naut_end;
-	double astr_start, astr_end;
-	int rs, civ, naut, astr;
 	char bufr[10], bufs[10];
+	size_t i;
 
-	daylen = day_length(year, month, day, lon, lat);
-	civlen = day_civil_twilight_length(year, month, day, lon, lat);
-	nautlen = day_nautical_twilight_length(year, month, day, lon, lat);
-	astrlen = day_astronomical_twilight_length(year, month, day, lon, lat);
+	if (cache)
+		sunriset_cache_get(cache, year, month, day, ev);
+	else
+		sunriset_events(year, month, day, lon, lat, ev, NELEMS(ev));
+	daylen  = ev[0].daylen;
+	civlen  = ev[1].daylen;
+	nautlen = ev[2].daylen;
+	astrlen = ev[3].daylen;
 
 	PRINTF("Day length:                 %5.2f hours\n", daylen);
 	PRINTF("With civil twilight         %5.2f hours\n", civlen);
@@ -184,112 +293,465 @@ static int all(double lat, double lon, int year, int month, int day)
 	PRINTF("                  nautical  %5.2f hours\n", (nautlen - daylen) / 2.0);
 	PRINTF("              astronomical  %5.2f hours\n", (astrlen - daylen) / 2.0);
 
-	rs = sun_rise_set(year, month, day, lon, lat, &rise, &set);
-	civ = civil_twilight(year, month, day, lon, lat, &civ_start, &civ_end);
-	naut = nautical_twilight(year, month, day, lon, lat, &naut_start, &naut_end);
-	astr = astronomical_twilight(year, month, day, lon, lat, &astr_start, &astr_end);
+	PRINTF("Sun at south %s %s\n", lctime(date, (ev[0].rise + ev[0].set) / 2.0), tm->tm_zone);
 
-	PRINTF("Sun at south %s %s\n", lctime((rise + set) / 2.0), tm->tm_zone);
+	for (i = 0; i < NELEMS(ev); i++) {
+		switch (ev[i].rc) {
+		case 0:
+			printf(fmt[i][0],
+			       lctime_r(date, ev[i].rise, bufr, sizeof(bufr)),
+			       lctime_r(date, ev[i].set, bufs, sizeof(bufs)), tm->tm_zone);
+			break;
 
-	switch (rs) {
-	case 0:
-		printf("Sun rises %s, sets %s %s\n",
-		       lctime_r(rise, bufr, sizeof(bufr)),
-		       lctime_r(set, bufs, sizeof(bufs)), tm->tm_zone);
-		break;
+		case +1:
+			PRINTF("%s", fmt[i][1]);
+			break;
 
-	case +1:
-		PRINTF("Sun above horizon\n");
-		break;
+		case -1:
+			PRINTF("%s", fmt[i][2]);
+			break;
+		}
+	}
 
-	case -1:
-		PRINTF("Sun below horizon\n");
-		break;
+	return 0;
+}
+
+/*
+ * Stream the Sun's altitude and azimuth over the day, from local
+ * midnight, one line every step seconds
+ */
+static int trace(double lat, double lon, int year, int month, int day, int step)
+{
+	double alt[256], az[256], d, sec = 0.0;
+	size_t i, n;
+
+	if (step <= 0 || step > 24 * 3600)
+		return 1;
+
+	d = days_since_2000_Jan_0(year, month, day) - timediff(midnight(year, month, day)) / 86400.0;
+	n = 24 * 3600 / step;
+
+	PRINTF("Time      Altitude  Azimuth (%s)\n", tm->tm_zone);
+	for (i = 0; i < n; i += NELEMS(alt)) {
+		size_t j, m = n - i < NELEMS(alt) ? n - i : NELEMS(alt);
+
+		sun_alt_az_series(d + sec / 86400.0, step / 86400.0, m, lon, lat, alt, az);
+		for (j = 0; j < m; j++, sec += step) {
+			int s = (int)sec;
+
+			printf("%02d:%02d:%02d  %8.3f  %7.3f\n", s / 3600, s / 60 % 60,
+			       s % 60, alt[j], az[j]);
+		}
 	}
 
-	switch (civ) {
-	case 0:
-		printf("Civil twilight starts %s, ends %s %s\n",
-		       lctime_r(civ_start, bufr, sizeof(bufr)),
-		       lctime_r(civ_end, bufs, sizeof(bufs)), tm->tm_zone);
-		break;
+	return 0;
+}
 
-	case +1:
-		PRINTF("Never darker than civil twilight\n");
-		break;
+/*
+ * Twilight types of the --fleet device table
+ */
+static const struct {
+	const char *name;
+	double      altit;
+	int         upper_limb;
+} twilight[] = {
+	{ "sunset",       -35.0 / 60.0, 1 },
+	{ "civil",         -6.0,        0 },
+	{ "nautical",     -12.0,        0 },
+	{ "astronomical", -18.0,        0 },
+};
 
-	case -1:
-		PRINTF("Never as bright as civil twilight\n");
-		break;
+/*
+ * Merged, time-ordered switching events of all devices in file for the
+ * next 24 hours.  One device per line: ID LAT LON [TYPE [ON [OFF]]],
+ * where TYPE is one of the twilight[] names and ON and OFF are offsets
+ * to set and rise, e.g. -30m.
+ */
+static int fleet(const char *file)
+{
+	struct sunriset_device *dev = NULL;
+	struct sunriset_fleet_event ev;
+	struct timespec t0, t1, t2;
+	size_t n = 0, max = 0, events = 0, lineno = 0;
+	char **id = NULL, buf[256];
+	sunriset_fleet *f;
+	int rc = 1;
+	double sec;
+	FILE *fp;
+
+	fp = strcmp(file, "-") ? fopen(file, "r") : stdin;
+	if (!fp) {
+		perror(file);
+		return 1;
 	}
 
-	switch (naut) {
-	case 0:
-		printf("Nautical twilight starts %s, ends %s %s\n",
-		       lctime_r(naut_start, bufr, sizeof(bufr)),
-		       lctime_r(naut_end, bufs, sizeof(bufs)), tm->tm_zone);
-		break;
+	while (fgets(buf, sizeof(buf), fp)) {
+		char name[64], type[16] = "sunset", on[16] = "0", off[16] = "0";
+		size_t i;
+		int num;
 
-	case +1:
-		PRINTF("Never darker than nautical twilight\n");
-		break;
+		lineno++;
+		if (buf[0] == '#' || buf[0] == '\n')
+			continue;
 
-	case -1:
-		PRINTF("Never as bright as nautical twilight\n");
-		break;
+		if (n == max) {
+			void *d, *p;
+
+			max = max ? 2 * max : 1024;
+			d = realloc(dev, max * sizeof(*dev));
+			p = realloc(id, max * sizeof(*id));
+			if (d)
+				dev = d;
+			if (p)
+				id = p;
+			if (!d || !p) {
+				fprintf(stderr, "Out of memory\n");
+				goto done;
+			}
+		}
+
+		num = sscanf(buf, "%63s %lf %lf %15s %15s %15s", name, &dev[n].lat,
+			     &dev[n].lon, type, on, off);
+		for (i = 0; i < NELEMS(twilight); i++) {
+			if (!strcmp(twilight[i].name, type))
+				break;
+		}
+		if (num < 3 || i == NELEMS(twilight)) {
+			fprintf(stderr, "%s:%zu: invalid device\n", file, lineno);
+			goto done;
+		}
+
+		dev[n].altit      = twilight[i].altit;
+		dev[n].upper_limb = twilight[i].upper_limb;
+		dev[n].on_offset  = convert_offset(on);
+		dev[n].off_offset = convert_offset(off);
+		id[n] = strdup(name);
+		if (!id[n]) {
+			fprintf(stderr, "Out of memory\n");
+			goto done;
+		}
+		n++;
 	}
+	if (fp != stdin)
+		fclose(fp);
+	fp = NULL;
 
-	switch (astr) {
-	case 0:
-		printf("Astronomical twilight starts %s, ends %s %s\n",
-		       lctime_r(astr_start, bufr, sizeof(bufr)),
-		       lctime_r(astr_end, bufs, sizeof(bufs)), tm->tm_zone);
-		break;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	f = sunriset_fleet_open(dev, n, now, now + 24 * 3600);
+	if (!f) {
+		fprintf(stderr, "Failed computing fleet schedule\n");
+		goto done;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	while (sunriset_fleet_next(f, &ev)) {
+		long diff = timediff(ev.when);
+		time_t t = ev.when + diff;
+		struct tm when;
+		char date[32];
+
+		/* Shifted to local time, the offset is looked up per event */
+		gmtime_r(&t, &when);
+		when.tm_gmtoff = diff;
+		strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &when);
+		printf("%s %s %s\n", date, id[ev.device], ev.on ? "on" : "off");
+		events++;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t2);
+	sunriset_fleet_close(f);
+
+	sec = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	fprintf(stderr, "%zu devices, %zu events, compiled in %.3f s, %.0f devices/sec",
+		n, events, sec, sec > 0.0 ? n / sec : 0.0);
+	sec = (t2.tv_sec - t0.tv_sec) + (t2.tv_nsec - t0.tv_nsec) / 1e9;
+	fprintf(stderr, ", %.0f devices/sec incl. output\n", sec > 0.0 ? n / sec : 0.0);
+	rc = 0;
+done:
+	if (fp && fp != stdin)
+		fclose(fp);
+	while (n--)
+		free(id[n]);
+	free(id);
+	free(dev);
 
-	case +1:
-		PRINTF("Never darker than astronomical twilight\n");
-		break;
+	return rc;
+}
 
-	case -1:
-		PRINTF("Never as bright as astronomical twilight\n");
-		break;
+/* Print a polyline as GeoJSON, split where it crosses the antimeridian */
+static void geojson_line(const double *lon, const double *lat, size_t n)
+{
+	size_t i;
+
+	printf("{ \"type\": \"MultiLineString\", \"coordinates\": [ [ [%.4f, %.4f]", lon[0], lat[0]);
+	for (i = 1; i < n; i++) {
+		double dlon = lon[i] - lon[i - 1];
+
+		if (fabs(dlon) > 180.0) {
+			double edge = lon[i - 1] > 0.0 ? 180.0 : -180.0;
+			double f, y;
+
+			/* Latitude where the line meets the edge of the map */
+			dlon += dlon > 0.0 ? -360.0 : 360.0;
+			f = (edge - lon[i - 1]) / dlon;
+			y = lat[i - 1] + f * (lat[i] - lat[i - 1]);
+			printf(", [%.4f, %.4f] ], [ [%.4f, %.4f]", edge, y, -edge, y);
+		}
+		printf(", [%.4f, %.4f]", lon[i], lat[i]);
 	}
+	printf(" ] ] }");
+}
+
+/*
+ * Equinoxes and solstices of the hundred years from the given year, or
+ * from the start of this century, in local time
+ */
+static int seasons(const char *arg)
+{
+	const char *name[] = {
+		"March equinox", "June solstice", "September equinox", "December solstice"
+	};
+	struct timespec t0, t1;
+	time_t t[100][4];
+	int from, to, y, i;
+
+	from = arg ? atoi(arg) : (1900 + tm->tm_year - 1) / 100 * 100 + 1;
+	if (from < 1801 || from > 2099) {
+		fprintf(stderr, "Invalid year %s, use 1801-2099\n", arg);
+		return 1;
+	}
+	to = from + 99 < 2099 ? from + 99 : 2099;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (y = from; y <= to; y++) {
+		for (i = 0; i < 4; i++)
+			t[y - from][i] = sunriset_season(y, i);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	for (y = from; y <= to; y++) {
+		for (i = 0; i < 4; i++) {
+			long diff = timediff(t[y - from][i]);
+			time_t local = t[y - from][i] + diff;
+			struct tm when;
+			char date[32];
+
+			gmtime_r(&local, &when);
+			when.tm_gmtoff = diff;
+			strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &when);
+			printf("%s %s\n", date, name[i]);
+		}
+	}
+
+	fprintf(stderr, "%d seasons in %.3f ms\n", (to - from + 1) * 4,
+		((t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9) * 1e3);
 
 	return 0;
 }
 
-static void chomp(char *str)
+/*
+ * The terminator and twilight boundaries at an instant, given as
+ * YYYY-MM-DDTHH:MM[:SS] UTC, or now, as a GeoJSON FeatureCollection
+ */
+static int terminator(const char *arg)
 {
-	size_t len;
+	struct {
+		const char *name;
+		double      altit;
+	} line[] = {
+		{ "sunrise/sunset", -50.0 / 60.0 },	/* Upper limb at -35' */
+		{ "civil",           -6.0 },
+		{ "nautical",       -12.0 },
+		{ "astronomical",   -18.0 },
+	};
+	double lon[4096], lat[4096], d, slon, slat;
+	struct tm date;
+	time_t t = now;
+	size_t i, n;
+
+	if (arg) {
+		memset(&date, 0, sizeof(date));
+		if (sscanf(arg, "%d-%d-%dT%d:%d:%d", &date.tm_year, &date.tm_mon, &date.tm_mday,
+			   &date.tm_hour, &date.tm_min, &date.tm_sec) < 5) {
+			fprintf(stderr, "Invalid time %s, use YYYY-MM-DDTHH:MM[:SS]\n", arg);
+			return 1;
+		}
+		date.tm_year -= 1900;
+		date.tm_mon  -= 1;
+		t = timegm(&date);
+	}
 
-	if (!str)
-		return;
+	/* Days since 2000 Jan 0.0 UT */
+	d = t / 86400.0 - 10956.0;
+	sunriset_subsolar(d, &slon, &slat);
+
+	printf("{ \"type\": \"FeatureCollection\", \"features\": [\n");
+	printf("  { \"type\": \"Feature\", \"properties\": { \"name\": \"subsolar\" }, "
+	       "\"geometry\": { \"type\": \"Point\", \"coordinates\": [%.4f, %.4f] } }",
+	       slon, slat);
+	for (i = 0; i < NELEMS(line); i++) {
+		n = sunriset_terminator(d, line[i].altit, 0.1, lon, lat, NELEMS(lon));
+		if (n > NELEMS(lon))
+			n = NELEMS(lon);
+
+		printf(",\n  { \"type\": \"Feature\", \"properties\": { \"name\": \"%s\", "
+		       "\"altitude\": %.4f }, \"geometry\": ", line[i].name, line[i].altit);
+		geojson_line(lon, lat, n);
+		printf(" }");
+	}
+	printf("\n] }\n");
 
-	len = strlen(str) - 1;
-	while (len && str[len] == '\n')
-		str[len--] = 0;
+	return 0;
+}
+
+/*
+ * Open cache for location, in $XDG_CACHE_HOME/sun or ~/.cache/sun
+ * unless a directory is given with --cache=DIR
+ */
+static sunriset_cache *cache_open(double lat, double lon)
+{
+	char path[256], *home;
+
+	if (cachedir)
+		return sunriset_cache_open(cachedir, lon, lat);
+
+	home = getenv("XDG_CACHE_HOME");
+	if (home) {
+		snprintf(path, sizeof(path), "%s/sun", home);
+	} else {
+		home = getenv("HOME");
+		if (!home)
+			return NULL;
+
+		snprintf(path, sizeof(path), "%s/.cache", home);
+		mkdir(path, 0755);
+		snprintf(path, sizeof(path), "%s/.cache/sun", home);
+	}
+
+	return sunriset_cache_open(path, lon, lat);
+}
+
+/*
+ * Parse a date on the form YYYY-MM-DD
+ */
+static int parse_date(char *arg, struct tm *date)
+{
+	int day;
+
+	memset(date, 0, sizeof(*date));
+	if (!arg || sscanf(arg, "%d-%d-%d", &date->tm_year, &date->tm_mon, &date->tm_mday) != 3)
+		return 0;
+
+	date->tm_year -= 1900;
+	date->tm_mon  -= 1;
+	date->tm_hour  = 12;
+	day = date->tm_mday;
+
+	/* timegm() normalizes, e.g. February 31 to March 3 */
+	if (timegm(date) == (time_t)-1 || date->tm_mday != day)
+		return 0;
+
+	return 1;
+}
+
+/*
+ * One row per day, from and to inclusive, computed by the incremental
+ * range engine rather than one __sunriset__() per day.
+ */
+static int table(double lat, double lon, struct tm *from, struct tm *to)
+{
+	struct sunriset_event ev = { .altit = -35.0 / 60.0, .upper_limb = 1 };
+	struct sunriset_range r;
+	char bufr[10], bufs[10];
+	time_t t, end;
+
+	t   = timegm(from);
+	end = timegm(to);
+	if (end < t)
+		return 1;
+
+	sunriset_range_init(&r, 1900 + from->tm_year, 1 + from->tm_mon, from->tm_mday, lon, lat);
+
+	PRINTF("Date        Rise   Set    Length (%s)\n", tm->tm_zone);
+	for (; t <= end; t += 24 * 3600) {
+		struct tm date;
+
+		gmtime_r(&t, &date);
+		sunriset_range_next(&r, &ev, 1);
+		if (ev.rc) {
+			strcpy(bufr, "--:--");
+			strcpy(bufs, "--:--");
+		} else {
+			lctime_r(t - 12 * 3600, ev.rise, bufr, sizeof(bufr));
+			lctime_r(t - 12 * 3600, ev.set, bufs, sizeof(bufs));
+		}
+
+		printf("%04d-%02d-%02d  %s  %s  %5.2f\n", 1900 + date.tm_year,
+		       1 + date.tm_mon, date.tm_mday, bufr, bufs, ev.daylen);
+	}
+
+	return 0;
 }
 
-static int alias(char *tz, size_t len)
+/*
+ * Earliest and latest sunrise and sunset of the year, and its longest
+ * and shortest day.  The extremes are of the times in UT, which differ
+ * from those on the clock only when daylight saving time is in effect.
+ */
+static int extremes(double lat, double lon, int year)
 {
+	struct sunriset_extremes ex;
+	const struct {
+		const char *name;
+		struct sunriset_extreme *e;
+		int len;
+	} row[] = {
+		{ "Earliest sunrise", &ex.earliest_rise, 0 },
+		{ "Latest sunrise",   &ex.latest_rise,   0 },
+		{ "Earliest sunset",  &ex.earliest_set,  0 },
+		{ "Latest sunset",    &ex.latest_set,    0 },
+		{ "Longest day",      &ex.longest,       1 },
+		{ "Shortest day",     &ex.shortest,      1 },
+	};
 	size_t i;
 
-	for (i = 0; i < NELEMS(tzalias); i++) {
-		if (strcmp(tzalias[i].name, tz))
+	sunriset_extremes(year, lon, lat, -35.0 / 60.0, 1, &ex);
+
+	PRINTF("Extremes of %d      Date        Time (%s)\n", year, tm->tm_zone);
+	for (i = 0; i < NELEMS(row); i++) {
+		const struct sunriset_extreme *e = row[i].e;
+		char buf[10];
+
+		if (!e->month) {
+			printf("%-20s  none\n", row[i].name);
 			continue;
+		}
 
-		strncpy(tz, tzalias[i].alias, len);
-		return 1;
+		if (row[i].len)
+			snprintf(buf, sizeof(buf), "%5.2f", e->value);
+		else
+			lctime_r(midnight(year, e->month, e->day), e->value, buf, sizeof(buf));
+		printf("%-20s  %04d-%02d-%02d  %s\n", row[i].name, year, e->month, e->day, buf);
 	}
 
 	return 0;
 }
 
+static void chomp(char *str)
+{
+	size_t len;
+
+	if (!str)
+		return;
+
+	len = strlen(str) - 1;
+	while (len && str[len] == '\n')
+		str[len--] = 0;
+}
+
 static int probe(double *lat, double *lon)
 {
-	int found = 0, again = 0;
 	FILE *fp;
-	char *ptr, tz[42], buf[80];
+	char *ptr, tz[42];
 
 	ptr = getenv("TZ");
 	if (!ptr) {
@@ -299,48 +761,34 @@ static int probe(double *lat, double *lon)
 
 		if (fgets(tz, sizeof(tz), fp))
 			chomp(tz);
+		else
+			tz[0] = 0;
 		fclose(fp);
-	} else {
-		strncpy(tz, ptr, sizeof(tz));
-		tz[sizeof(tz) - 1] = 0;
+		ptr = tz;
 	}
 
-retry:
-//	printf("tz: '%s'\n", tz);
-	fp = fopen(ZONETAB, "r");
-	if (!fp)
-		return 0;
+	/* Compiled-in table of zones and aliases, see tzalias.sh */
+	return sunriset_zone(ptr, lon, lat);
+}
 
-	while ((fgets(buf, sizeof(buf), fp))) {
-		ptr = strstr(buf, tz);
-		if (!ptr)
-			continue;
-		*ptr = 0;
-		ptr = buf;
-		while (*ptr != ' ' && *ptr != '	')
-			ptr++;
-
-		if (sscanf(ptr, "%lf%lf", lat, lon) == 2) {
-			*lat /= 100.0;
-			*lon /= 100.0;
-			found = 1;
-		}
-//		printf("buf: '%s', lat: %lf, lon: %lf\n", ptr, *lat, *lon);
-		break;
-	}
-	fclose(fp);
-
-	if (!found) {
-//		printf("Cannot find your coordinates using time zone: %s\n", tz);
-		if (!again) {
-			again++;
-			if (alias(tz, sizeof(tz)))
-				goto retry;
-		}
-//		puts("");
-	}
+/*
+ * Switch to the time zone nearest to a location, for the local date and
+ * the zone abbreviation as well as the UT offset of each event
+ */
+static struct tm *zone_nearest(double lat, double lon)
+{
+	const char *name;
+
+	name = sunriset_zone_nearest(lon, lat);
+	if (verbose > 1)
+		printf("Time zone %s\n", name);
 
-	return found;
+	setenv("TZ", name, 1);
+	tzset();
+	sunriset_tz_close(zone);
+	zone = sunriset_tz_open(name);
+
+	return localtime(&now);
 }
 
 static int interactive(double *lat, double *lon, int *year, int *month, int *day)
@@ -361,7 +809,11 @@ static int interactive(double *lat, double *lon, int *year, int *month, int *day
 static int usage(int code)
 {
 	printf("Usage:\n"
-	       "  %s [-ahirsw] [-o OFFSET] [+/-latitude +/-longitude]\n"
+	       "  %s [-ahirsw] [-o OFFSET] [--batch] [--cache[=DIR]] [--table FROM TO]\n"
+	       "      [--trace[=SEC]] [--daemon=FILE] [--fleet FILE] [--zone]\n"
+	       "      [--raster FILE [DATE] [--grid DEG] [--minutes]] [--threads NUM]\n"
+	       "      [--terminator[=TIME]] [--extremes YEAR] [--seasons[=YEAR]]\n"
+	       "      [+/-latitude +/-longitude]\n"
 	       "\n"
 	       "Options:\n"
 	       "  -a      Show all relevant times and exit\n"
@@ -376,6 +828,37 @@ static int usage(int code)
 	       "  -o ARG  Time offset to adjust wait, e.g. -o -30m\n"
 	       "          maximum allowed offset: +/- 6h\n"
 	       "\n"
+	       "  --daemon=FILE    Run hooks from FILE at daily events, one rule per\n"
+	       "                   line: EVENT [OFFSET] run COMMAND, e.g.\n"
+	       "                   \"sunset -30m run lights on\", reload on SIGHUP\n"
+	       "  --fleet FILE     Switching events of all devices in FILE for the\n"
+	       "                   next 24h, in time order.  One device per line:\n"
+	       "                   ID LAT LON [sunset|civil|nautical|astronomical\n"
+	       "                   [ON [OFF]]], offsets to set and rise, e.g. -30m\n"
+	       "  --batch          Read LAT,LON,YYYY-MM-DD rows, or NDJSON objects with\n"
+	       "                   lat, lon and date, from stdin and add rise, set and\n"
+	       "                   day length, with --threads workers, default one per CPU\n"
+	       "  --cache[=DIR]    Keep computed times in a per-location cache file,\n"
+	       "                   default DIR: $XDG_CACHE_HOME/sun or ~/.cache/sun\n"
+	       "  --raster FILE [DATE]  Write rise, set and day length of every cell\n"
+	       "                   of a global grid to FILE for DATE, YYYY-MM-DD,\n"
+	       "                   default today, as float32 hours UT, or int16\n"
+	       "                   minutes with --minutes.  The grid, default 0.1\n"
+	       "                   degrees, must divide 180 degrees\n"
+	       "  --terminator[=TIME]  Day/night and twilight boundaries as GeoJSON, at\n"
+	       "                   TIME, YYYY-MM-DDTHH:MM[:SS] UTC, default now\n"
+	       "  --seasons[=YEAR] Equinoxes and solstices of the hundred years from\n"
+	       "                   YEAR, default this century, to 2099 at most\n"
+	       "  --threads NUM    Worker threads for --batch and --raster\n"
+	       "  --extremes YEAR  Show the earliest and latest sunrise and sunset,\n"
+	       "                   and the longest and shortest day of YEAR\n"
+	       "  --table FROM TO  Show sunrise, sunset and day length for each\n"
+	       "                   day in range, dates as YYYY-MM-DD\n"
+	       "  --trace[=SEC]    Show the Sun's altitude and azimuth over the day,\n"
+	       "                   every SEC seconds, default 60\n"
+	       "  --zone           Use the local time of the time zone nearest to\n"
+	       "                   the given location, not the TZ of the system\n"
+	       "\n"
 	       "Bug report address: %s\n",
 	       __progname, PACKAGE_BUGREPORT);
 
@@ -384,12 +867,93 @@ static int usage(int code)
 
 int main(int argc, char *argv[])
 {
-	int c, op = 0, ok = 0;
-	int year, month, day;
+	struct option long_options[] = {
+		{ "batch", no_argument, NULL, 'B' },
+		{ "cache", optional_argument, NULL, 'C' },
+		{ "daemon", required_argument, NULL, 'D' },
+		{ "extremes", required_argument, NULL, 'E' },
+		{ "fleet", required_argument, NULL, 'F' },
+		{ "grid", required_argument, NULL, 'G' },
+		{ "minutes", no_argument, NULL, 'M' },
+		{ "raster", required_argument, NULL, 'R' },
+		{ "seasons", optional_argument, NULL, 'S' },
+		{ "table", required_argument, NULL, 'T' },
+		{ "terminator", optional_argument, NULL, 'X' },
+		{ "threads", required_argument, NULL, 'N' },
+		{ "trace", optional_argument, NULL, 'P' },
+		{ "zone", no_argument, NULL, 'Z' },
+		{ NULL, 0, NULL, 0 }
+	};
+	struct tm from, to;
+	char *file = NULL;
+	int c, op = 0, ok = 0, threads = 0, type = RASTER_FLOAT32;
+	int year, month, day, xyear = 0, rdate = 0;
+	double grid = 0.1;
 	double lon = 0.0, lat;
 
-	while ((c = getopt(argc, argv, "ahilo:rsuvw")) != EOF) {
+	while ((c = getopt_long(argc, argv, "ahilo:rsuvw", long_options, NULL)) != EOF) {
 		switch (c) {
+		case 'B':
+			op = c;
+			break;
+
+		case 'C':
+			use_cache = 1;
+			cachedir = optarg;
+			break;
+
+		case 'D':
+		case 'F':
+		case 'R':
+		case 'S':
+		case 'X':
+			file = optarg;
+			op = c;
+
+			/* A map is of one date, default today */
+			if (c == 'R' && optind < argc && strchr(argv[optind], '-') > argv[optind]) {
+				if (!parse_date(argv[optind++], &from))
+					return usage(1);
+				rdate = 1;
+			}
+			break;
+
+		case 'G':
+			grid = atof(optarg);
+			break;
+
+		case 'M':
+			type = RASTER_INT16;
+			break;
+
+		case 'N':
+			threads = atoi(optarg);
+			break;
+
+		case 'T':
+			if (!parse_date(optarg, &from) || optind >= argc ||
+			    !parse_date(argv[optind++], &to))
+				return usage(1);
+			op = c;
+			break;
+
+		case 'P':
+			if (optarg)
+				step = atoi(optarg);
+			op = c;
+			break;
+
+		case 'E':
+			xyear = atoi(optarg);
+			if (xyear < 1801 || xyear > 2099)
+				return usage(1);
+			op = c;
+			break;
+
+		case 'Z':
+			nearest = 1;
+			break;
+
 		case 'h':
 			return usage(0);
 
@@ -436,10 +1000,12 @@ int main(int argc, char *argv[])
 	}
 
 	now = time(NULL);
-	if (utc)
+	if (utc) {
 		tm = gmtime(&now);
-	else
+	} else {
 		tm = localtime(&now);
+		zone = sunriset_tz_open(NULL);
+	}
 
 	if (!ok) {
 		if (optind < argc)
@@ -447,6 +1013,10 @@ int main(int argc, char *argv[])
 		if (optind < argc)
 			lon = atof(argv[optind]);
 
+		/* Local time of the zone nearest to the given location */
+		if (nearest && lon != 0.0 && !utc)
+			tm = zone_nearest(lat, lon);
+
 		year = 1900 + tm->tm_year;
 		month = 1 + tm->tm_mon;
 		day = tm->tm_mday;
@@ -464,9 +1034,27 @@ int main(int argc, char *argv[])
 		tm->tm_mday = day;
 	}
 
+	/* Each device of a fleet, and each row of a batch, has its own location */
+	if (op == 'F')
+		return fleet(file);
+	if (op == 'B')
+		return batch_run(threads, zone, utc ? 0 : tm->tm_gmtoff);
+	if (op == 'R' && rdate)
+		return raster_run(file, 1900 + from.tm_year, 1 + from.tm_mon, from.tm_mday,
+				  grid, type, threads);
+	if (op == 'R')
+		return raster_run(file, year, month, day, grid, type, threads);
+	if (op == 'X')
+		return terminator(file);
+	if (op == 'S')
+		return seasons(file);
+
 	if (!ok)
 		return usage(1);
 
+	if (use_cache)
+		cache = cache_open(lat, lon);
+
 	switch (op) {
 	case 'a':
 		return all(lat, lon, year, month, day);
@@ -477,6 +1065,18 @@ int main(int argc, char *argv[])
 	case 's':
 		return sunset(lat, lon, year, month, day);
 
+	case 'T':
+		return table(lat, lon, &from, &to);
+
+	case 'E':
+		return extremes(lat, lon, xyear);
+
+	case 'D':
+		return daemon_run(file, lat, lon, verbose - 1);
+
+	case 'P':
+		return trace(lat, lon, year, month, day, step);
+
 	default:
 		verbose++;
 		break;
@@ -0,0 +1,64 @@
+/*
+
+Fixed-point SUNRISET for controllers without an FPU
+
+Released to the public domain
+
+ */
+#ifndef SUNRISET_FIXED_H_
+#define SUNRISET_FIXED_H_
+
+#include <stdint.h>
+
+/* Angles are binary, 2^32 per turn, so that a full turn wraps around  */
+/* by itself.  Longitude as int32_t is then [-180,180) degrees, with  */
+/* 180 the same angle as -180, and latitude -90..90 degrees.  Use     */
+/* SUNRISET_FIXED_DEG() for constants, the conversion is done by the  */
+/* compiler, and angles outside [-180,180) wrap around as they should */
+#define SUNRISET_FIXED_DEG(deg)  \
+        ((int32_t)(uint32_t)(int64_t)((deg) * 11930464.711111111))
+
+/* Following are the same macros as in sunriset.h, with the times in  */
+/* seconds UT from 0h of the date, which may be negative or beyond a  */
+/* day, and day lengths in seconds.                                   */
+
+#define day_length_fixed(year,month,day,lon,lat)  \
+        __daylen_fixed__( year, month, day, lon, lat, \
+                          SUNRISET_FIXED_DEG(-35.0/60.0), 1 )
+
+#define day_civil_twilight_length_fixed(year,month,day,lon,lat)  \
+        __daylen_fixed__( year, month, day, lon, lat, \
+                          SUNRISET_FIXED_DEG(-6.0), 0 )
+
+#define day_nautical_twilight_length_fixed(year,month,day,lon,lat)  \
+        __daylen_fixed__( year, month, day, lon, lat, \
+                          SUNRISET_FIXED_DEG(-12.0), 0 )
+
+#define day_astronomical_twilight_length_fixed(year,month,day,lon,lat)  \
+        __daylen_fixed__( year, month, day, lon, lat, \
+                          SUNRISET_FIXED_DEG(-18.0), 0 )
+
+#define sun_rise_set_fixed(year,month,day,lon,lat,rise,set)  \
+        __sunriset_fixed__( year, month, day, lon, lat, \
+                            SUNRISET_FIXED_DEG(-35.0/60.0), 1, rise, set )
+
+#define civil_twilight_fixed(year,month,day,lon,lat,start,end)  \
+        __sunriset_fixed__( year, month, day, lon, lat, \
+                            SUNRISET_FIXED_DEG(-6.0), 0, start, end )
+
+#define nautical_twilight_fixed(year,month,day,lon,lat,start,end)  \
+        __sunriset_fixed__( year, month, day, lon, lat, \
+                            SUNRISET_FIXED_DEG(-12.0), 0, start, end )
+
+#define astronomical_twilight_fixed(year,month,day,lon,lat,start,end)  \
+        __sunriset_fixed__( year, month, day, lon, lat, \
+                            SUNRISET_FIXED_DEG(-18.0), 0, start, end )
+
+int __sunriset_fixed__( int year, int month, int day, int32_t lon, int32_t lat,
+                        int32_t altit, int upper_limb, int32_t *trise,
+                        int32_t *tset );
+
+int32_t __daylen_fixed__( int year, int month, int day, int32_t lon,
+                          int32_t lat, int32_t altit, int upper_limb );
+
+#endif /* SUNRISET_FIXED_H_ */
@@ -0,0 +1,146 @@
+/*
+
+Day/night terminator and twilight boundaries at one instant
+
+The Sun is overhead at the subsolar point, at latitude = declination
+and longitude = RA - GMST, from sun_RA_dec() and GMST0().  The points
+where it is at altitude altit form a small circle around it, at an
+angular distance of 90 - altit degrees.  The circle is traced by the
+bearing from the subsolar point, and returned as a closed polyline of
+longitude and latitude for plotting on a map.
+
+On such a map the circle is stretched, flat across most longitudes and
+turning sharply where it passes near a pole.  Each span of bearing is
+therefore halved for as long as its midpoint lies more than tol degrees
+off the straight line between its ends, so the points are dense only
+where they are needed.  A few hundred points at tol = 0.1 is typical,
+which takes some tens of microseconds.
+
+Released to the public domain
+
+ */
+#include <math.h>
+
+#include "sunriset.h"
+
+/* Spans of bearing to start from, and the most times one is halved */
+#define SPANS  16
+#define DEPTH  20
+
+struct circle {
+	double lon;			/* Subsolar point */
+	double sinlat, coslat;
+	double sinrho, cosrho;		/* Radius of the circle */
+	double tol;
+	double *lon_out, *lat_out;
+	size_t max, n;
+};
+
+struct point {
+	double theta;
+	double dlon;			/* Longitude from the subsolar point */
+	double lat;
+};
+
+void sunriset_subsolar( double d, double *lon, double *lat )
+{
+	double RA, dec, r;
+
+	sun_RA_dec(d, &RA, &dec, &r);
+
+	*lat = dec;
+	*lon = rev180(RA - GMST0(d) - 360.0 * (d - floor(d)));
+}
+
+/* Point at bearing theta from the subsolar point, on the circle */
+static void point(const struct circle *c, double theta, struct point *p)
+{
+	double sinlat;
+
+	sinlat = c->sinlat * c->cosrho + c->coslat * c->sinrho * cosd(theta);
+	p->theta = theta;
+	p->lat   = asind(sinlat);
+	p->dlon  = atan2d(sind(theta) * c->sinrho * c->coslat,
+			  c->cosrho - c->sinlat * sinlat);
+}
+
+static void emit(struct circle *c, const struct point *p)
+{
+	if (c->n < c->max) {
+		c->lon_out[c->n] = rev180(c->lon + p->dlon);
+		c->lat_out[c->n] = p->lat;
+	}
+	c->n++;
+}
+
+/* Longitude of b relative to a, across the antimeridian if closer */
+static double unwrap(double a, double b)
+{
+	if (b - a > 180.0)
+		return b - 360.0;
+	if (b - a < -180.0)
+		return b + 360.0;
+
+	return b;
+}
+
+/* Emit the points after a, up to and including b */
+static void span(struct circle *c, const struct point *a, const struct point *b, int depth)
+{
+	struct point m;
+	double dlon, dlat;
+
+	point(c, (a->theta + b->theta) / 2.0, &m);
+
+	dlon = unwrap(a->dlon, m.dlon) - (a->dlon + unwrap(a->dlon, b->dlon)) / 2.0;
+	dlat = m.lat - (a->lat + b->lat) / 2.0;
+	if (depth < DEPTH && dlon * dlon + dlat * dlat > c->tol * c->tol) {
+		span(c, a, &m, depth + 1);
+		span(c, &m, b, depth + 1);
+		return;
+	}
+
+	emit(c, b);
+}
+
+size_t sunriset_terminator( double d, double altit, double tol,
+                            double *lon, double *lat, size_t max )
+{
+	struct point a, b;
+	struct circle c;
+	double slon, slat;
+	int i;
+
+	if (altit <= -90.0 || altit >= 90.0 || tol <= 0.0)
+		return 0;
+
+	sunriset_subsolar(d, &slon, &slat);
+
+	c.lon     = slon;
+	c.sinlat  = sind(slat);
+	c.coslat  = cosd(slat);
+	c.sinrho  = sind(90.0 - altit);
+	c.cosrho  = cosd(90.0 - altit);
+	c.tol     = tol;
+	c.lon_out = lon;
+	c.lat_out = lat;
+	c.max     = max;
+	c.n       = 0;
+
+	point(&c, 0.0, &a);
+	emit(&c, &a);
+	for (i = 1; i <= SPANS; i++) {
+		point(&c, 360.0 * i / SPANS, &b);
+		span(&c, &a, &b, 0);
+		a = b;
+	}
+
+	return c.n;
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
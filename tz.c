@@ -0,0 +1,458 @@
+/*
+
+Local time offsets from TZif files, without localtime()
+
+The zone's TZif file, RFC 8536, is memory-mapped once and the offset of
+any instant is found by a binary search of its transition times, which
+the caller can do millions of times, from any number of threads,
+without the locking and environment lookups of localtime().  Instants
+after the last transition use the POSIX TZ rule in the file's footer,
+e.g. "CET-1CEST,M3.5.0,M10.5.0/3", and a TZ value that is not a file is
+parsed as such a rule directly.
+
+Released to the public domain
+
+ */
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sunriset.h"
+
+#define ZONEINFO "/usr/share/zoneinfo"
+#define LOCALTIME "/etc/localtime"
+
+/* Day of a POSIX TZ rule, Jn, n or Mm.w.d, and time of day */
+struct when {
+	char kind;		/* 'J', 'n' or 'M' */
+	int  n, m, w, d;
+	long time;		/* Seconds after local midnight */
+};
+
+struct rule {
+	long        std, dst;	/* UT offsets, seconds east */
+	char        stdname[16], dstname[16];
+	int         has_dst;
+	struct when start, end;
+};
+
+struct sunriset_tz {
+	unsigned char       *map;
+	size_t               len;
+	const unsigned char *times;	/* Transition times, big endian */
+	const unsigned char *idx;	/* Type index per transition */
+	const unsigned char *types;	/* ttinfo, 6 bytes each */
+	const char          *abbr;
+	size_t               size;	/* Of a transition time, 4 or 8 */
+	uint32_t             timecnt, typecnt, charcnt;
+	int                  has_rule;
+	struct rule          rule;
+};
+
+static long num(const char **p)
+{
+	char *end;
+	long v;
+
+	v = strtol(*p, &end, 10);
+	*p = end;
+
+	return v;
+}
+
+static uint32_t be32(const unsigned char *p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static int64_t be64(const unsigned char *p)
+{
+	return (int64_t)((uint64_t)be32(p) << 32 | be32(p + 4));
+}
+
+static int64_t transition(const struct sunriset_tz *tz, uint32_t i)
+{
+	const unsigned char *p = tz->times + i * tz->size;
+
+	return tz->size == 8 ? be64(p) : (int32_t)be32(p);
+}
+
+/* Days since 1970-01-01 of a proleptic Gregorian date */
+static long days_from_civil(long y, int m, int d)
+{
+	long era, yoe, doy, doe;
+
+	y  -= m <= 2;
+	era = (y >= 0 ? y : y - 399) / 400;
+	yoe = y - era * 400;
+	doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+	return era * 146097 + doe - 719468;
+}
+
+static long year_of(time_t t)
+{
+	long z = (long)(t >= 0 ? t / 86400 : (t - 86399) / 86400) + 719468;
+	long era, doe, yoe, doy, mp;
+
+	era = (z >= 0 ? z : z - 146096) / 146097;
+	doe = z - era * 146097;
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp  = (5 * doy + 2) / 153;
+
+	return yoe + era * 400 + (mp >= 10);
+}
+
+static int leap(long y)
+{
+	return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+/* Local time of a rule's transition in year y, as seconds since epoch */
+static time_t when(long y, const struct when *w)
+{
+	static const int mdays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	long day;
+
+	switch (w->kind) {
+	case 'J':
+		day = days_from_civil(y, 1, 1) + w->n - 1 + (leap(y) && w->n >= 60);
+		break;
+
+	case 'M': {
+		int wday, mday, max = mdays[w->m - 1] + (w->m == 2 && leap(y));
+
+		day  = days_from_civil(y, w->m, 1);
+		wday = (int)((day % 7 + 11) % 7);	/* 1970-01-01 was a Thursday */
+		mday = 1 + (w->d - wday + 7) % 7 + 7 * (w->w - 1);
+		while (mday > max)
+			mday -= 7;
+		day += mday - 1;
+		break;
+	}
+
+	default:
+		day = days_from_civil(y, 1, 1) + w->n;
+		break;
+	}
+
+	return (time_t)day * 86400 + w->time;
+}
+
+static long rule_offset(const struct rule *r, time_t t, const char **abbr)
+{
+	time_t start, end;
+	long y;
+	int dst;
+
+	if (!r->has_dst) {
+		if (abbr)
+			*abbr = r->stdname;
+		return r->std;
+	}
+
+	y     = year_of(t + r->std);
+	start = when(y, &r->start) - r->std;
+	end   = when(y, &r->end) - r->dst;
+	if (start < end)
+		dst = t >= start && t < end;
+	else
+		dst = !(t >= end && t < start);
+
+	if (abbr)
+		*abbr = dst ? r->dstname : r->stdname;
+
+	return dst ? r->dst : r->std;
+}
+
+static const char *parse_name(const char *p, char *name, size_t len)
+{
+	size_t n = 0;
+
+	if (*p == '<') {
+		for (p++; *p && *p != '>'; p++) {
+			if (n + 1 < len)
+				name[n++] = *p;
+		}
+		if (*p++ != '>')
+			return NULL;
+	} else {
+		for (; (*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'); p++) {
+			if (n + 1 < len)
+				name[n++] = *p;
+		}
+	}
+	name[n] = 0;
+
+	return n >= 3 ? p : NULL;
+}
+
+/* [+-]hh[:mm[:ss]], in seconds */
+static const char *parse_time(const char *p, long *sec)
+{
+	long v, sign = 1;
+	int i;
+
+	if (*p == '+' || *p == '-')
+		sign = *p++ == '-' ? -1 : 1;
+	if (*p < '0' || *p > '9')
+		return NULL;
+
+	v = num(&p) * 3600;
+	for (i = 60; i >= 1 && *p == ':'; i /= 60) {
+		p++;
+		v += num(&p) * i;
+	}
+	*sec = sign * v;
+
+	return p;
+}
+
+static const char *parse_when(const char *p, struct when *w)
+{
+	w->time = 2 * 3600;
+	if (*p == 'M') {
+		w->kind = 'M';
+		p++;
+		w->m = num(&p);
+		if (*p++ != '.')
+			return NULL;
+		w->w = num(&p);
+		if (*p++ != '.')
+			return NULL;
+		w->d = num(&p);
+		if (w->m < 1 || w->m > 12 || w->w < 1 || w->w > 5 || w->d < 0 || w->d > 6)
+			return NULL;
+	} else {
+		w->kind = *p == 'J' ? 'J' : 'n';
+		if (*p == 'J')
+			p++;
+		if (*p < '0' || *p > '9')
+			return NULL;
+		w->n = num(&p);
+		if (w->kind == 'J' ? w->n < 1 || w->n > 365 : w->n > 365)
+			return NULL;
+	}
+
+	if (*p == '/')
+		p = parse_time(p + 1, &w->time);
+
+	return p;
+}
+
+/* POSIX TZ string, e.g. CET-1CEST,M3.5.0,M10.5.0/3 */
+static int parse_rule(const char *p, struct rule *r)
+{
+	long off;
+
+	memset(r, 0, sizeof(*r));
+	p = parse_name(p, r->stdname, sizeof(r->stdname));
+	if (!p || !(p = parse_time(p, &off)))
+		return 0;
+	r->std = r->dst = -off;
+	if (!*p)
+		return 1;
+
+	p = parse_name(p, r->dstname, sizeof(r->dstname));
+	if (!p)
+		return 0;
+	r->has_dst = 1;
+	r->dst = r->std + 3600;
+	if (*p && *p != ',') {
+		if (!(p = parse_time(p, &off)))
+			return 0;
+		r->dst = -off;
+	}
+
+	/* No rule, use the US one like glibc */
+	if (!*p)
+		p = ",M3.2.0,M11.1.0";
+	if (*p++ != ',' || !(p = parse_when(p, &r->start)))
+		return 0;
+	if (*p++ != ',' || !(p = parse_when(p, &r->end)))
+		return 0;
+
+	return *p == 0;
+}
+
+/*
+ * Check header and locate the data block, the 64-bit one of version 2
+ * and later files, returns the end of the data block or NULL
+ */
+static const unsigned char *header(struct sunriset_tz *tz, const unsigned char *p, size_t size)
+{
+	const unsigned char *end = tz->map + tz->len;
+	uint32_t isutcnt, isstdcnt, leapcnt;
+
+	if (end - p < 44 || memcmp(p, "TZif", 4))
+		return NULL;
+
+	isutcnt     = be32(p + 20);
+	isstdcnt    = be32(p + 24);
+	leapcnt     = be32(p + 28);
+	tz->timecnt = be32(p + 32);
+	tz->typecnt = be32(p + 36);
+	tz->charcnt = be32(p + 40);
+	tz->size    = size;
+	p += 44;
+
+	if (tz->typecnt == 0 ||
+	    (size_t)(end - p) < tz->timecnt * (size + 1) + tz->typecnt * 6 + tz->charcnt +
+	    leapcnt * (size + 4) + isstdcnt + isutcnt)
+		return NULL;
+
+	tz->times = p;
+	tz->idx   = p + tz->timecnt * size;
+	tz->types = tz->idx + tz->timecnt;
+	tz->abbr  = (const char *)tz->types + tz->typecnt * 6;
+
+	return (const unsigned char *)tz->abbr + tz->charcnt + leapcnt * (size + 4) +
+		isstdcnt + isutcnt;
+}
+
+static int load(struct sunriset_tz *tz, const char *path)
+{
+	const unsigned char *p;
+	struct stat st;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	if (fstat(fd, &st) || st.st_size < 44) {
+		close(fd);
+		return 0;
+	}
+
+	tz->len = st.st_size;
+	tz->map = mmap(NULL, tz->len, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (tz->map == MAP_FAILED) {
+		tz->map = NULL;
+		return 0;
+	}
+
+	p = header(tz, tz->map, 4);
+	if (!p)
+		return 0;
+
+	/* Version 2+, skip to the 64-bit data and the footer */
+	if (tz->map[4] >= '2') {
+		const unsigned char *end = tz->map + tz->len;
+		char footer[64];
+		size_t n;
+
+		p = header(tz, p, 8);
+		if (!p)
+			return 0;
+
+		if (p < end && *p == '\n') {
+			for (n = 0, p++; p < end && *p != '\n' && n + 1 < sizeof(footer); p++)
+				footer[n++] = *p;
+			footer[n] = 0;
+			tz->has_rule = n > 0 && parse_rule(footer, &tz->rule);
+		}
+	}
+
+	return 1;
+}
+
+sunriset_tz *sunriset_tz_open( const char *name )
+{
+	struct sunriset_tz *tz;
+	char path[256];
+
+	if (!name)
+		name = getenv("TZ");
+	if (name && *name == ':')
+		name++;
+
+	tz = calloc(1, sizeof(*tz));
+	if (!tz)
+		return NULL;
+
+	if (!name || !*name) {
+		if (load(tz, LOCALTIME))
+			return tz;
+	} else {
+		const char *dir = getenv("TZDIR");
+
+		if (*name == '/')
+			snprintf(path, sizeof(path), "%s", name);
+		else
+			snprintf(path, sizeof(path), "%s/%s", dir ? dir : ZONEINFO, name);
+		if (!strstr(name, "..") && load(tz, path))
+			return tz;
+
+		/* Not a file, try as a POSIX TZ rule */
+		if (tz->map)
+			munmap(tz->map, tz->len);
+		memset(tz, 0, sizeof(*tz));
+		if (parse_rule(name, &tz->rule)) {
+			tz->has_rule = 1;
+			return tz;
+		}
+	}
+
+	sunriset_tz_close(tz);
+	return NULL;
+}
+
+long sunriset_tz_offset( const sunriset_tz *tz, time_t t, const char **abbr )
+{
+	const unsigned char *type;
+	uint32_t lo, hi;
+
+	if (!tz)
+		return 0;
+
+	if (tz->has_rule && (tz->timecnt == 0 || t >= transition(tz, tz->timecnt - 1)))
+		return rule_offset(&tz->rule, t, abbr);
+
+	/* Before the first transition time type 0 applies, RFC 8536 */
+	if (tz->timecnt == 0 || t < transition(tz, 0)) {
+		type = tz->types;
+	} else {
+		/* Last transition at or before t */
+		lo = 0;
+		hi = tz->timecnt;
+		while (hi - lo > 1) {
+			uint32_t mid = lo + (hi - lo) / 2;
+
+			if (transition(tz, mid) <= t)
+				lo = mid;
+			else
+				hi = mid;
+		}
+		type = tz->types + 6 * (tz->idx[lo] < tz->typecnt ? tz->idx[lo] : 0);
+	}
+
+	if (abbr)
+		*abbr = type[5] < tz->charcnt ? tz->abbr + type[5] : "";
+
+	return (int32_t)be32(type);
+}
+
+void sunriset_tz_close( sunriset_tz *tz )
+{
+	if (!tz)
+		return;
+
+	if (tz->map)
+		munmap(tz->map, tz->len);
+	free(tz);
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */
@@ -1,208 +1,1156 @@
 /* This is a generated file, see tzalias.sh to update it */
+/* tzdata version 2025b */
 
-struct tz_alias {
-	char *name;
-	char *alias;
-} tzalias[] = {
-	{ "Africa/Addis_Ababa", "Africa/Nairobi" },
-	{ "Africa/Asmara", "Africa/Nairobi" },
-	{ "Africa/Asmera", "Africa/Asmara" },
-	{ "Africa/Asmera", "Africa/Nairobi" },
-	{ "Africa/Bamako", "Africa/Abidjan" },
-	{ "Africa/Bangui", "Africa/Lagos" },
-	{ "Africa/Banjul", "Africa/Abidjan" },
-	{ "Africa/Blantyre", "Africa/Maputo" },
-	{ "Africa/Brazzaville", "Africa/Lagos" },
-	{ "Africa/Bujumbura", "Africa/Maputo" },
-	{ "Africa/Conakry", "Africa/Abidjan" },
-	{ "Africa/Dakar", "Africa/Abidjan" },
-	{ "Africa/Dar_es_Salaam", "Africa/Nairobi" },
-	{ "Africa/Djibouti", "Africa/Nairobi" },
-	{ "Africa/Douala", "Africa/Lagos" },
-	{ "Africa/Freetown", "Africa/Abidjan" },
-	{ "Africa/Gaborone", "Africa/Maputo" },
-	{ "Africa/Harare", "Africa/Maputo" },
-	{ "Africa/Kampala", "Africa/Nairobi" },
-	{ "Africa/Kigali", "Africa/Maputo" },
-	{ "Africa/Kinshasa", "Africa/Lagos" },
-	{ "Africa/Libreville", "Africa/Lagos" },
-	{ "Africa/Lome", "Africa/Abidjan" },
-	{ "Africa/Luanda", "Africa/Lagos" },
-	{ "Africa/Lubumbashi", "Africa/Maputo" },
-	{ "Africa/Lusaka", "Africa/Maputo" },
-	{ "Africa/Malabo", "Africa/Lagos" },
-	{ "Africa/Maseru", "Africa/Johannesburg" },
-	{ "Africa/Mbabane", "Africa/Johannesburg" },
-	{ "Africa/Mogadishu", "Africa/Nairobi" },
-	{ "Africa/Niamey", "Africa/Lagos" },
-	{ "Africa/Nouakchott", "Africa/Abidjan" },
-	{ "Africa/Ouagadougou", "Africa/Abidjan" },
-	{ "Africa/Porto-Novo", "Africa/Lagos" },
-	{ "Africa/Sao_Tome", "Africa/Abidjan" },
-	{ "Africa/Timbuktu", "Africa/Abidjan" },
-	{ "America/Anguilla", "America/Port_of_Spain" },
-	{ "America/Antigua", "America/Port_of_Spain" },
-	{ "America/Argentina/ComodRivadavia", "America/Argentina/Catamarca" },
-	{ "America/Aruba", "America/Curacao" },
-	{ "America/Atka", "America/Adak" },
-	{ "America/Buenos_Aires", "America/Argentina/Buenos_Aires" },
-	{ "America/Catamarca", "America/Argentina/Catamarca" },
-	{ "America/Cayman", "America/Panama" },
-	{ "America/Coral_Harbour", "America/Atikokan" },
-	{ "America/Cordoba", "America/Argentina/Cordoba" },
-	{ "America/Dominica", "America/Port_of_Spain" },
-	{ "America/Ensenada", "America/Tijuana" },
-	{ "America/Fort_Wayne", "America/Indiana/Indianapolis" },
-	{ "America/Grenada", "America/Port_of_Spain" },
-	{ "America/Guadeloupe", "America/Port_of_Spain" },
-	{ "America/Indianapolis", "America/Indiana/Indianapolis" },
-	{ "America/Jujuy", "America/Argentina/Jujuy" },
-	{ "America/Knox_IN", "America/Indiana/Knox" },
-	{ "America/Kralendijk", "America/Curacao" },
-	{ "America/Louisville", "America/Kentucky/Louisville" },
-	{ "America/Lower_Princes", "America/Curacao" },
-	{ "America/Marigot", "America/Port_of_Spain" },
-	{ "America/Mendoza", "America/Argentina/Mendoza" },
-	{ "America/Montreal", "America/Toronto" },
-	{ "America/Montserrat", "America/Port_of_Spain" },
-	{ "America/Porto_Acre", "America/Rio_Branco" },
-	{ "America/Rosario", "America/Argentina/Cordoba" },
-	{ "America/Santa_Isabel", "America/Tijuana" },
-	{ "America/Shiprock", "America/Denver" },
-	{ "America/St_Barthelemy", "America/Port_of_Spain" },
-	{ "America/St_Kitts", "America/Port_of_Spain" },
-	{ "America/St_Lucia", "America/Port_of_Spain" },
-	{ "America/St_Thomas", "America/Port_of_Spain" },
-	{ "America/St_Vincent", "America/Port_of_Spain" },
-	{ "America/Tortola", "America/Port_of_Spain" },
-	{ "America/Virgin", "America/Port_of_Spain" },
-	{ "Antarctica/McMurdo", "Pacific/Auckland" },
-	{ "Antarctica/South_Pole", "Antarctica/McMurdo" },
-	{ "Antarctica/South_Pole", "Pacific/Auckland" },
-	{ "Arctic/Longyearbyen", "Europe/Oslo" },
-	{ "Asia/Ashkhabad", "Asia/Ashgabat" },
-	{ "Asia/Calcutta", "Asia/Kolkata" },
-	{ "Asia/Chongqing", "Asia/Shanghai" },
-	{ "Asia/Chungking", "Asia/Chongqing" },
-	{ "Asia/Chungking", "Asia/Shanghai" },
-	{ "Asia/Dacca", "Asia/Dhaka" },
-	{ "Asia/Harbin", "Asia/Shanghai" },
-	{ "Asia/Istanbul", "Europe/Istanbul" },
-	{ "Asia/Kashgar", "Asia/Urumqi" },
-	{ "Asia/Katmandu", "Asia/Kathmandu" },
-	{ "Asia/Macao", "Asia/Macau" },
-	{ "Asia/Rangoon", "Asia/Yangon" },
-	{ "Asia/Saigon", "Asia/Ho_Chi_Minh" },
-	{ "Asia/Tel_Aviv", "Asia/Jerusalem" },
-	{ "Asia/Thimbu", "Asia/Thimphu" },
-	{ "Asia/Ujung_Pandang", "Asia/Makassar" },
-	{ "Asia/Ulan_Bator", "Asia/Ulaanbaatar" },
-	{ "Atlantic/Faeroe", "Atlantic/Faroe" },
-	{ "Atlantic/Jan_Mayen", "Europe/Oslo" },
-	{ "Atlantic/St_Helena", "Africa/Abidjan" },
-	{ "Australia/ACT", "Australia/Sydney" },
-	{ "Australia/Canberra", "Australia/Sydney" },
-	{ "Australia/LHI", "Australia/Lord_Howe" },
-	{ "Australia/North", "Australia/Darwin" },
-	{ "Australia/NSW", "Australia/Sydney" },
-	{ "Australia/Queensland", "Australia/Brisbane" },
-	{ "Australia/South", "Australia/Adelaide" },
-	{ "Australia/Tasmania", "Australia/Hobart" },
-	{ "Australia/Victoria", "Australia/Melbourne" },
-	{ "Australia/West", "Australia/Perth" },
-	{ "Australia/Yancowinna", "Australia/Broken_Hill" },
-	{ "Brazil/Acre", "America/Rio_Branco" },
-	{ "Brazil/DeNoronha", "America/Noronha" },
-	{ "Brazil/East", "America/Sao_Paulo" },
-	{ "Brazil/West", "America/Manaus" },
-	{ "Canada/Atlantic", "America/Halifax" },
-	{ "Canada/Central", "America/Winnipeg" },
-	{ "Canada/Eastern", "America/Toronto" },
-	{ "Canada/Mountain", "America/Edmonton" },
-	{ "Canada/Newfoundland", "America/St_Johns" },
-	{ "Canada/Pacific", "America/Vancouver" },
-	{ "Canada/Saskatchewan", "America/Regina" },
-	{ "Canada/Yukon", "America/Whitehorse" },
-	{ "Chile/Continental", "America/Santiago" },
-	{ "Chile/EasterIsland", "Pacific/Easter" },
-	{ "Cuba", "America/Havana" },
-	{ "Egypt", "Africa/Cairo" },
-	{ "Eire", "Europe/Dublin" },
-	{ "Etc/GMT-0", "Etc/GMT" },
-	{ "Etc/GMT+0", "Etc/GMT" },
-	{ "Etc/GMT0", "Etc/GMT" },
-	{ "Etc/Greenwich", "Etc/GMT" },
-	{ "Etc/Universal", "Etc/UTC" },
-	{ "Etc/Zulu", "Etc/UTC" },
-	{ "Europe/Belfast", "Europe/London" },
-	{ "Europe/Bratislava", "Europe/Prague" },
-	{ "Europe/Busingen", "Europe/Zurich" },
-	{ "Europe/Guernsey", "Europe/London" },
-	{ "Europe/Isle_of_Man", "Europe/London" },
-	{ "Europe/Jersey", "Europe/London" },
-	{ "Europe/Ljubljana", "Europe/Belgrade" },
-	{ "Europe/Mariehamn", "Europe/Helsinki" },
-	{ "Europe/Podgorica", "Europe/Belgrade" },
-	{ "Europe/San_Marino", "Europe/Rome" },
-	{ "Europe/Sarajevo", "Europe/Belgrade" },
-	{ "Europe/Skopje", "Europe/Belgrade" },
-	{ "Europe/Tiraspol", "Europe/Chisinau" },
-	{ "Europe/Vaduz", "Europe/Zurich" },
-	{ "Europe/Vatican", "Europe/Rome" },
-	{ "Europe/Zagreb", "Europe/Belgrade" },
-	{ "GB-Eire", "Europe/London" },
-	{ "GB", "Europe/London" },
-	{ "GMT-0", "Etc/GMT" },
-	{ "GMT+0", "Etc/GMT" },
-	{ "GMT0", "Etc/GMT" },
-	{ "GMT", "Etc/GMT" },
-	{ "Greenwich", "Etc/GMT" },
-	{ "Hongkong", "Asia/Hong_Kong" },
-	{ "Iceland", "Atlantic/Reykjavik" },
-	{ "Indian/Antananarivo", "Africa/Nairobi" },
-	{ "Indian/Comoro", "Africa/Nairobi" },
-	{ "Indian/Mayotte", "Africa/Nairobi" },
-	{ "Iran", "Asia/Tehran" },
-	{ "Israel", "Asia/Jerusalem" },
-	{ "Jamaica", "America/Jamaica" },
-	{ "Japan", "Asia/Tokyo" },
-	{ "Kwajalein", "Pacific/Kwajalein" },
-	{ "Libya", "Africa/Tripoli" },
-	{ "Mexico/BajaNorte", "America/Tijuana" },
-	{ "Mexico/BajaSur", "America/Mazatlan" },
-	{ "Mexico/General", "America/Mexico_City" },
-	{ "Navajo", "America/Denver" },
-	{ "NZ-CHAT", "Pacific/Chatham" },
-	{ "NZ", "Pacific/Auckland" },
-	{ "Pacific/Johnston", "Pacific/Honolulu" },
-	{ "Pacific/Midway", "Pacific/Pago_Pago" },
-	{ "Pacific/Ponape", "Pacific/Pohnpei" },
-	{ "Pacific/Saipan", "Pacific/Guam" },
-	{ "Pacific/Samoa", "Pacific/Pago_Pago" },
-	{ "Pacific/Truk", "Pacific/Chuuk" },
-	{ "Pacific/Yap", "Pacific/Chuuk" },
-	{ "Poland", "Europe/Warsaw" },
-	{ "Portugal", "Europe/Lisbon" },
-	{ "PRC", "Asia/Shanghai" },
-	{ "ROC", "Asia/Taipei" },
-	{ "ROK", "Asia/Seoul" },
-	{ "Singapore", "Asia/Singapore" },
-	{ "Turkey", "Europe/Istanbul" },
-	{ "UCT", "Etc/UCT" },
-	{ "Universal", "Etc/UTC" },
-	{ "US/Alaska", "America/Anchorage" },
-	{ "US/Aleutian", "America/Adak" },
-	{ "US/Arizona", "America/Phoenix" },
-	{ "US/Central", "America/Chicago" },
-	{ "US/Eastern", "America/New_York" },
-	{ "US/East-Indiana", "America/Indiana/Indianapolis" },
-	{ "US/Hawaii", "Pacific/Honolulu" },
-	{ "US/Indiana-Starke", "America/Indiana/Knox" },
-	{ "US/Michigan", "America/Detroit" },
-	{ "US/Mountain", "America/Denver" },
-	{ "US/Pacific", "America/Los_Angeles" },
-	{ "US/Samoa", "Pacific/Pago_Pago" },
-	{ "UTC", "Etc/UTC" },
-	{ "W-SU", "Europe/Moscow" },
-	{ "Zulu", "Etc/UTC" },
+#include <stdint.h>
+
+#define TZ_ZONES    542
+#define TZ_BUCKETS  136
+
+static const char tz_pool[] =
+	"Pacific/Kosrae\0"
+	"America/Rankin_Inlet\0"
+	"Africa/Lubumbashi\0"
+	"Asia/Srednekolymsk\0"
+	"US/Eastern\0"
+	"ROK\0"
+	"America/Danmarkshavn\0"
+	"Pacific/Nauru\0"
+	"Africa/Maputo\0"
+	"Asia/Singapore\0"
+	"Europe/Riga\0"
+	"Europe/Busingen\0"
+	"America/Rosario\0"
+	"Europe/Sofia\0"
+	"Antarctica/DumontDUrville\0"
+	"Atlantic/Jan_Mayen\0"
+	"Japan\0"
+	"Europe/Lisbon\0"
+	"America/Guadeloupe\0"
+	"Pacific/Tahiti\0"
+	"America/Shiprock\0"
+	"Asia/Omsk\0"
+	"America/Ciudad_Juarez\0"
+	"America/Mendoza\0"
+	"Asia/Ulan_Bator\0"
+	"Brazil/Acre\0"
+	"Pacific/Tongatapu\0"
+	"Africa/Douala\0"
+	"Australia/NSW\0"
+	"America/Asuncion\0"
+	"Pacific/Palau\0"
+	"America/St_Thomas\0"
+	"America/Panama\0"
+	"America/Indiana/Indianapolis\0"
+	"Atlantic/Reykjavik\0"
+	"Asia/Almaty\0"
+	"America/Thule\0"
+	"America/Anguilla\0"
+	"America/Coral_Harbour\0"
+	"Asia/Famagusta\0"
+	"Europe/Brussels\0"
+	"Pacific/Marquesas\0"
+	"Australia/Lord_Howe\0"
+	"Kwajalein\0"
+	"Europe/Zaporozhye\0"
+	"US/Indiana-Starke\0"
+	"Europe/Podgorica\0"
+	"America/Argentina/Catamarca\0"
+	"Atlantic/Madeira\0"
+	"Jamaica\0"
+	"Europe/Dublin\0"
+	"Asia/Jayapura\0"
+	"Asia/Kamchatka\0"
+	"Israel\0"
+	"Europe/Gibraltar\0"
+	"Antarctica/Syowa\0"
+	"Indian/Kerguelen\0"
+	"Europe/Tirane\0"
+	"Europe/Vatican\0"
+	"America/North_Dakota/Beulah\0"
+	"Asia/Makassar\0"
+	"America/Argentina/Cordoba\0"
+	"Antarctica/Vostok\0"
+	"Mexico/BajaSur\0"
+	"Pacific/Fakaofo\0"
+	"Europe/Paris\0"
+	"Europe/Mariehamn\0"
+	"America/New_York\0"
+	"Europe/Prague\0"
+	"Pacific/Kanton\0"
+	"Indian/Cocos\0"
+	"Asia/Ashkhabad\0"
+	"Asia/Riyadh\0"
+	"Europe/Budapest\0"
+	"Africa/Luanda\0"
+	"Antarctica/Macquarie\0"
+	"Asia/Choibalsan\0"
+	"America/Kentucky/Monticello\0"
+	"Pacific/Pohnpei\0"
+	"America/Whitehorse\0"
+	"Pacific/Gambier\0"
+	"America/Louisville\0"
+	"Antarctica/Rothera\0"
+	"Asia/Hong_Kong\0"
+	"Europe/Sarajevo\0"
+	"Europe/Moscow\0"
+	"America/Chihuahua\0"
+	"Pacific/Samoa\0"
+	"Asia/Nicosia\0"
+	"Asia/Thimphu\0"
+	"Asia/Sakhalin\0"
+	"America/Nuuk\0"
+	"Asia/Ujung_Pandang\0"
+	"America/Knox_IN\0"
+	"America/Goose_Bay\0"
+	"Asia/Aden\0"
+	"America/Tortola\0"
+	"Australia/Eucla\0"
+	"Asia/Harbin\0"
+	"America/Indiana/Knox\0"
+	"Africa/Kigali\0"
+	"Africa/Addis_Ababa\0"
+	"Europe/Isle_of_Man\0"
+	"Asia/Shanghai\0"
+	"America/Indiana/Tell_City\0"
+	"America/Guatemala\0"
+	"America/Winnipeg\0"
+	"Pacific/Efate\0"
+	"Europe/Zurich\0"
+	"Pacific/Majuro\0"
+	"America/North_Dakota/New_Salem\0"
+	"America/Argentina/San_Juan\0"
+	"Pacific/Easter\0"
+	"America/Caracas\0"
+	"Australia/Queensland\0"
+	"America/Recife\0"
+	"America/Montreal\0"
+	"America/Puerto_Rico\0"
+	"Africa/Lusaka\0"
+	"America/Coyhaique\0"
+	"Asia/Qyzylorda\0"
+	"Asia/Kuching\0"
+	"America/Maceio\0"
+	"America/Paramaribo\0"
+	"America/Antigua\0"
+	"Europe/Guernsey\0"
+	"America/Martinique\0"
+	"Europe/Belfast\0"
+	"Asia/Oral\0"
+	"America/Argentina/Salta\0"
+	"America/Mazatlan\0"
+	"Africa/Casablanca\0"
+	"America/La_Paz\0"
+	"America/Port-au-Prince\0"
+	"America/Sitka\0"
+	"W-SU\0"
+	"Europe/Vilnius\0"
+	"Europe/Ljubljana\0"
+	"Cuba\0"
+	"America/Jujuy\0"
+	"Europe/Helsinki\0"
+	"America/Thunder_Bay\0"
+	"America/Nome\0"
+	"Asia/Pyongyang\0"
+	"Africa/Porto-Novo\0"
+	"Europe/Simferopol\0"
+	"Europe/Stockholm\0"
+	"Pacific/Wake\0"
+	"Atlantic/South_Georgia\0"
+	"America/Blanc-Sablon\0"
+	"Poland\0"
+	"America/Yakutat\0"
+	"America/Fort_Nelson\0"
+	"America/Anchorage\0"
+	"Indian/Comoro\0"
+	"Asia/Qatar\0"
+	"America/Argentina/San_Luis\0"
+	"Indian/Antananarivo\0"
+	"Africa/Abidjan\0"
+	"Pacific/Rarotonga\0"
+	"Asia/Yakutsk\0"
+	"Africa/Tripoli\0"
+	"Asia/Tomsk\0"
+	"America/Indianapolis\0"
+	"Eire\0"
+	"Australia/Darwin\0"
+	"Asia/Krasnoyarsk\0"
+	"Europe/Saratov\0"
+	"America/St_Kitts\0"
+	"Pacific/Pitcairn\0"
+	"America/Dawson\0"
+	"Indian/Mahe\0"
+	"America/Bogota\0"
+	"Europe/Zagreb\0"
+	"America/Mexico_City\0"
+	"America/Ojinaga\0"
+	"America/Dawson_Creek\0"
+	"Africa/Mbabane\0"
+	"Asia/Seoul\0"
+	"America/Cayenne\0"
+	"Pacific/Pago_Pago\0"
+	"America/Kentucky/Louisville\0"
+	"Africa/Bujumbura\0"
+	"Asia/Dushanbe\0"
+	"Asia/Baghdad\0"
+	"Africa/Bissau\0"
+	"America/Iqaluit\0"
+	"America/Hermosillo\0"
+	"America/Argentina/Ushuaia\0"
+	"Asia/Dili\0"
+	"Africa/Malabo\0"
+	"America/Marigot\0"
+	"Australia/Canberra\0"
+	"Asia/Chungking\0"
+	"America/Scoresbysund\0"
+	"Pacific/Bougainville\0"
+	"Chile/EasterIsland\0"
+	"Europe/Ulyanovsk\0"
+	"Australia/South\0"
+	"America/Dominica\0"
+	"Atlantic/Canary\0"
+	"Australia/Lindeman\0"
+	"Asia/Katmandu\0"
+	"Iceland\0"
+	"America/Indiana/Vevay\0"
+	"Pacific/Galapagos\0"
+	"Asia/Barnaul\0"
+	"Europe/Copenhagen\0"
+	"PRC\0"
+	"Asia/Kabul\0"
+	"Asia/Jerusalem\0"
+	"America/Montserrat\0"
+	"Mexico/General\0"
+	"Asia/Tel_Aviv\0"
+	"Antarctica/Troll\0"
+	"America/Belem\0"
+	"ROC\0"
+	"Pacific/Guadalcanal\0"
+	"Asia/Tokyo\0"
+	"Asia/Taipei\0"
+	"US/Hawaii\0"
+	"America/Indiana/Vincennes\0"
+	"America/Araguaina\0"
+	"America/Fort_Wayne\0"
+	"America/Detroit\0"
+	"Africa/Dakar\0"
+	"America/Regina\0"
+	"Europe/Tallinn\0"
+	"Asia/Bishkek\0"
+	"America/Cancun\0"
+	"Antarctica/McMurdo\0"
+	"America/Phoenix\0"
+	"America/Rio_Branco\0"
+	"Asia/Phnom_Penh\0"
+	"Africa/Lagos\0"
+	"Asia/Irkutsk\0"
+	"America/Barbados\0"
+	"Antarctica/Davis\0"
+	"Europe/Monaco\0"
+	"America/Chicago\0"
+	"America/Grenada\0"
+	"America/St_Barthelemy\0"
+	"Europe/San_Marino\0"
+	"America/Nassau\0"
+	"America/Pangnirtung\0"
+	"America/El_Salvador\0"
+	"Pacific/Kwajalein\0"
+	"Africa/Niamey\0"
+	"America/Santo_Domingo\0"
+	"America/Moncton\0"
+	"America/Grand_Turk\0"
+	"US/Arizona\0"
+	"Brazil/DeNoronha\0"
+	"Asia/Urumqi\0"
+	"America/Indiana/Winamac\0"
+	"America/Bahia_Banderas\0"
+	"Indian/Reunion\0"
+	"Asia/Saigon\0"
+	"Europe/Chisinau\0"
+	"Africa/Ndjamena\0"
+	"America/Manaus\0"
+	"GB\0"
+	"Asia/Khandyga\0"
+	"Australia/Hobart\0"
+	"America/Swift_Current\0"
+	"Brazil/East\0"
+	"Europe/Belgrade\0"
+	"America/Denver\0"
+	"Europe/Oslo\0"
+	"Asia/Dhaka\0"
+	"Africa/Timbuktu\0"
+	"Africa/Kinshasa\0"
+	"Canada/Newfoundland\0"
+	"America/Curacao\0"
+	"GB-Eire\0"
+	"Pacific/Wallis\0"
+	"Canada/Mountain\0"
+	"America/Costa_Rica\0"
+	"Africa/Sao_Tome\0"
+	"America/Fortaleza\0"
+	"Asia/Dubai\0"
+	"America/Jamaica\0"
+	"Indian/Christmas\0"
+	"Asia/Macau\0"
+	"Asia/Aqtobe\0"
+	"Asia/Macao\0"
+	"Asia/Vientiane\0"
+	"Iran\0"
+	"Indian/Chagos\0"
+	"America/Bahia\0"
+	"America/Cambridge_Bay\0"
+	"Antarctica/South_Pole\0"
+	"Africa/Windhoek\0"
+	"America/Boise\0"
+	"America/Atikokan\0"
+	"Europe/Kiev\0"
+	"America/Catamarca\0"
+	"Pacific/Guam\0"
+	"Pacific/Truk\0"
+	"Asia/Muscat\0"
+	"Europe/Samara\0"
+	"America/North_Dakota/Center\0"
+	"Australia/North\0"
+	"Antarctica/Palmer\0"
+	"Pacific/Kiritimati\0"
+	"Africa/Gaborone\0"
+	"Asia/Ulaanbaatar\0"
+	"America/Halifax\0"
+	"Pacific/Chuuk\0"
+	"US/Alaska\0"
+	"America/Punta_Arenas\0"
+	"Europe/Athens\0"
+	"America/Godthab\0"
+	"Asia/Ho_Chi_Minh\0"
+	"Canada/Central\0"
+	"Africa/Algiers\0"
+	"America/Managua\0"
+	"Asia/Istanbul\0"
+	"Asia/Bangkok\0"
+	"Africa/Conakry\0"
+	"Asia/Yekaterinburg\0"
+	"Asia/Yerevan\0"
+	"Asia/Novokuznetsk\0"
+	"America/Resolute\0"
+	"Pacific/Johnston\0"
+	"America/Boa_Vista\0"
+	"Pacific/Saipan\0"
+	"Asia/Colombo\0"
+	"Asia/Karachi\0"
+	"Canada/Atlantic\0"
+	"NZ-CHAT\0"
+	"America/Sao_Paulo\0"
+	"Atlantic/Cape_Verde\0"
+	"Australia/Victoria\0"
+	"Europe/Bucharest\0"
+	"Asia/Kolkata\0"
+	"Hongkong\0"
+	"Australia/Adelaide\0"
+	"Turkey\0"
+	"Africa/Cairo\0"
+	"Pacific/Midway\0"
+	"Pacific/Niue\0"
+	"America/Argentina/ComodRivadavia\0"
+	"America/Santarem\0"
+	"Pacific/Yap\0"
+	"Africa/Nouakchott\0"
+	"Africa/Accra\0"
+	"America/Indiana/Petersburg\0"
+	"Europe/Nicosia\0"
+	"America/Juneau\0"
+	"Asia/Baku\0"
+	"America/Creston\0"
+	"Asia/Ashgabat\0"
+	"America/Nipigon\0"
+	"Africa/Djibouti\0"
+	"US/Aleutian\0"
+	"Asia/Beirut\0"
+	"Pacific/Auckland\0"
+	"Asia/Jakarta\0"
+	"America/Porto_Acre\0"
+	"Asia/Calcutta\0"
+	"Atlantic/Faeroe\0"
+	"Canada/Eastern\0"
+	"Singapore\0"
+	"Africa/Tunis\0"
+	"Australia/Sydney\0"
+	"Portugal\0"
+	"Africa/Bangui\0"
+	"Asia/Novosibirsk\0"
+	"US/Mountain\0"
+	"Europe/Istanbul\0"
+	"US/Samoa\0"
+	"Africa/Maseru\0"
+	"America/Edmonton\0"
+	"US/Central\0"
+	"Pacific/Ponape\0"
+	"Africa/Kampala\0"
+	"Asia/Dacca\0"
+	"Atlantic/Azores\0"
+	"Africa/Libreville\0"
+	"Europe/Vienna\0"
+	"America/Inuvik\0"
+	"Europe/Berlin\0"
+	"Australia/Melbourne\0"
+	"US/Pacific\0"
+	"Atlantic/Faroe\0"
+	"Asia/Tashkent\0"
+	"America/Metlakatla\0"
+	"America/Toronto\0"
+	"Africa/Ouagadougou\0"
+	"Europe/Warsaw\0"
+	"America/Port_of_Spain\0"
+	"Africa/Monrovia\0"
+	"Canada/Yukon\0"
+	"America/St_Lucia\0"
+	"America/Belize\0"
+	"Asia/Rangoon\0"
+	"America/St_Vincent\0"
+	"Pacific/Norfolk\0"
+	"America/Ensenada\0"
+	"America/Porto_Velho\0"
+	"Europe/Madrid\0"
+	"America/Atka\0"
+	"Mexico/BajaNorte\0"
+	"Africa/Blantyre\0"
+	"Asia/Hovd\0"
+	"America/Argentina/Jujuy\0"
+	"America/St_Johns\0"
+	"Africa/Mogadishu\0"
+	"Europe/Rome\0"
+	"Europe/Malta\0"
+	"America/Merida\0"
+	"Europe/Andorra\0"
+	"America/Menominee\0"
+	"Asia/Manila\0"
+	"Europe/Astrakhan\0"
+	"Asia/Thimbu\0"
+	"Antarctica/Casey\0"
+	"Asia/Kashgar\0"
+	"America/Cordoba\0"
+	"America/Montevideo\0"
+	"Atlantic/St_Helena\0"
+	"Africa/Banjul\0"
+	"Europe/Uzhgorod\0"
+	"America/Cuiaba\0"
+	"America/Glace_Bay\0"
+	"Africa/Freetown\0"
+	"Africa/Bamako\0"
+	"Africa/El_Aaiun\0"
+	"Europe/Volgograd\0"
+	"America/Noronha\0"
+	"Pacific/Honolulu\0"
+	"Australia/LHI\0"
+	"Asia/Tbilisi\0"
+	"Africa/Brazzaville\0"
+	"America/Matamoros\0"
+	"America/Argentina/Tucuman\0"
+	"Asia/Amman\0"
+	"America/Indiana/Marengo\0"
+	"Asia/Yangon\0"
+	"Asia/Atyrau\0"
+	"Asia/Samarkand\0"
+	"America/Tijuana\0"
+	"Pacific/Noumea\0"
+	"Atlantic/Bermuda\0"
+	"Asia/Qostanay\0"
+	"Pacific/Enderbury\0"
+	"Africa/Khartoum\0"
+	"Australia/Perth\0"
+	"America/Lower_Princes\0"
+	"Indian/Mauritius\0"
+	"Australia/Broken_Hill\0"
+	"America/Monterrey\0"
+	"Asia/Kuala_Lumpur\0"
+	"America/Rainy_River\0"
+	"Europe/Luxembourg\0"
+	"America/Vancouver\0"
+	"Asia/Ust-Nera\0"
+	"Australia/Tasmania\0"
+	"Canada/Pacific\0"
+	"America/Santa_Isabel\0"
+	"America/Cayman\0"
+	"Europe/Vaduz\0"
+	"Europe/Kyiv\0"
+	"Asia/Damascus\0"
+	"Asia/Chita\0"
+	"America/Kralendijk\0"
+	"Asia/Vladivostok\0"
+	"America/Eirunepe\0"
+	"Africa/Dar_es_Salaam\0"
+	"Europe/Skopje\0"
+	"America/Yellowknife\0"
+	"Asia/Kuwait\0"
+	"Asia/Brunei\0"
+	"Europe/Tiraspol\0"
+	"Pacific/Tarawa\0"
+	"Chile/Continental\0"
+	"Asia/Gaza\0"
+	"Europe/Kirov\0"
+	"Pacific/Port_Moresby\0"
+	"Africa/Asmera\0"
+	"Pacific/Fiji\0"
+	"Australia/Yancowinna\0"
+	"Asia/Anadyr\0"
+	"Brazil/West\0"
+	"Africa/Lome\0"
+	"America/Argentina/Rio_Gallegos\0"
+	"US/East-Indiana\0"
+	"Asia/Bahrain\0"
+	"America/Virgin\0"
+	"America/Guyana\0"
+	"Navajo\0"
+	"Australia/West\0"
+	"Asia/Chongqing\0"
+	"America/Tegucigalpa\0"
+	"America/Campo_Grande\0"
+	"US/Michigan\0"
+	"Africa/Harare\0"
+	"Asia/Pontianak\0"
+	"Europe/Bratislava\0"
+	"Africa/Johannesburg\0"
+	"America/Adak\0"
+	"America/Argentina/La_Rioja\0"
+	"Africa/Juba\0"
+	"Europe/Amsterdam\0"
+	"America/Argentina/Buenos_Aires\0"
+	"NZ\0"
+	"Europe/London\0"
+	"Indian/Mayotte\0"
+	"Egypt\0"
+	"Africa/Nairobi\0"
+	"Africa/Ceuta\0"
+	"Africa/Asmara\0"
+	"Europe/Minsk\0"
+	"America/Lima\0"
+	"America/Los_Angeles\0"
+	"Australia/ACT\0"
+	"Pacific/Apia\0"
+	"Canada/Saskatchewan\0"
+	"America/Buenos_Aires\0"
+	"Europe/Jersey\0"
+	"Asia/Tehran\0"
+	"America/Argentina/Mendoza\0"
+	"America/Guayaquil\0"
+	"Arctic/Longyearbyen\0"
+	"Asia/Hebron\0"
+	"America/Aruba\0"
+	"Europe/Kaliningrad\0"
+	"Antarctica/Mawson\0"
+	"Libya\0"
+	"Australia/Brisbane\0"
+	"Asia/Kathmandu\0"
+	"America/Santiago\0"
+	"America/Havana\0"
+	"Indian/Maldives\0"
+	"Atlantic/Stanley\0"
+	"Pacific/Chatham\0"
+	"America/Miquelon\0"
+	"Asia/Aqtau\0"
+	"Australia/Currie\0"
+	"Asia/Magadan\0"
+	"Pacific/Funafuti\0";
+
+/* Name offset in tz_pool[], latitude and longitude in seconds of arc */
+static const struct tz_zone {
+	uint32_t name;
+	int32_t  lat, lon;
+} tz_zone[TZ_ZONES] = {
+	{     0,   19140,   586740 },	/* Pacific/Kosrae */
+	{    15,  226140,  -331499 },	/* America/Rankin_Inlet */
+	{    36,  -42000,    98880 },	/* Africa/Lubumbashi */
+	{    54,  242880,   553380 },	/* Asia/Srednekolymsk */
+	{    73,  146571,  -266423 },	/* US/Eastern */
+	{    84,  135180,   457080 },	/* ROK */
+	{    88,  276360,   -67200 },	/* America/Danmarkshavn */
+	{   109,   -1860,   600900 },	/* Pacific/Nauru */
+	{   123,  -93480,   117300 },	/* Africa/Maputo */
+	{   137,    4620,   373860 },	/* Asia/Singapore */
+	{   152,  205020,    86760 },	/* Europe/Riga */
+	{   164,  171720,    31260 },	/* Europe/Busingen */
+	{   180, -113040,  -231060 },	/* America/Rosario */
+	{   196,  153660,    83940 },	/* Europe/Sofia */
+	{   209, -240000,   504060 },	/* Antarctica/DumontDUrville */
+	{   235,  189000,    48120 },	/* Atlantic/Jan_Mayen */
+	{   254,  128356,   503081 },	/* Japan */
+	{   260,  139380,   -32880 },	/* Europe/Lisbon */
+	{   274,   58440,  -221520 },	/* America/Guadeloupe */
+	{   293,  -63120,  -538440 },	/* Pacific/Tahiti */
+	{   308,  143061,  -377943 },	/* America/Shiprock */
+	{   325,  198000,   264240 },	/* Asia/Omsk */
+	{   335,  114240,  -383340 },	/* America/Ciudad_Juarez */
+	{   357, -118380,  -247740 },	/* America/Mendoza */
+	{   373,  172500,   384780 },	/* Asia/Ulan_Bator */
+	{   389,  -35880,  -244080 },	/* Brazil/Acre */
+	{   401,  -76080,  -630720 },	/* Pacific/Tongatapu */
+	{   419,   14580,    34920 },	/* Africa/Douala */
+	{   433, -121920,   544380 },	/* Australia/NSW */
+	{   447,  -90960,  -207600 },	/* America/Asuncion */
+	{   464,   26400,   484140 },	/* Pacific/Palau */
+	{   478,   66060,  -233760 },	/* America/St_Thomas */
+	{   496,   32280,  -286320 },	/* America/Panama */
+	{   511,  143166,  -310169 },	/* America/Indiana/Indianapolis */
+	{   540,  230940,   -78660 },	/* Atlantic/Reykjavik */
+	{   559,  155700,   277020 },	/* Asia/Almaty */
+	{   571,  275640,  -247620 },	/* America/Thule */
+	{   585,   65520,  -227040 },	/* America/Anguilla */
+	{   602,   32280,  -286320 },	/* America/Coral_Harbour */
+	{   624,  126420,   122220 },	/* Asia/Famagusta */
+	{   639,  183000,    15600 },	/* Europe/Brussels */
+	{   655,  -32400,  -502200 },	/* Pacific/Marquesas */
+	{   673, -113580,   572700 },	/* Australia/Lord_Howe */
+	{   693,   32700,   602400 },	/* Kwajalein */
+	{   703,  181560,   109860 },	/* Europe/Zaporozhye */
+	{   721,  148665,  -311850 },	/* US/Indiana-Starke */
+	{   739,  152760,    69360 },	/* Europe/Podgorica */
+	{   756, -102480,  -236820 },	/* America/Argentina/Catamarca */
+	{   784,  117480,   -60840 },	/* Atlantic/Madeira */
+	{   801,   64685,  -276456 },	/* Jamaica */
+	{   809,  192000,   -22500 },	/* Europe/Dublin */
+	{   823,   -9120,   506520 },	/* Asia/Jayapura */
+	{   837,  190860,   571140 },	/* Asia/Kamchatka */
+	{   852,  114410,   126806 },	/* Israel */
+	{   859,  130080,   -19260 },	/* Europe/Gibraltar */
+	{   876, -248422,   142524 },	/* Antarctica/Syowa */
+	{   893, -177670,   252783 },	/* Indian/Kerguelen */
+	{   910,  148800,    71400 },	/* Europe/Tirane */
+	{   924,  150848,    44831 },	/* Europe/Vatican */
+	{   939,  170151,  -366400 },	/* America/North_Dakota/Beulah */
+	{   967,  -18420,   429840 },	/* Asia/Makassar */
+	{   981, -113040,  -231060 },	/* America/Argentina/Cordoba */
+	{  1007, -282240,   384840 },	/* Antarctica/Vostok */
+	{  1025,   83580,  -383100 },	/* Mexico/BajaSur */
+	{  1040,  -33720,  -616440 },	/* Pacific/Fakaofo */
+	{  1056,  175920,     8400 },	/* Europe/Paris */
+	{  1069,  216360,    71820 },	/* Europe/Mariehamn */
+	{  1086,  146571,  -266423 },	/* America/New_York */
+	{  1103,  180300,    51960 },	/* Europe/Prague */
+	{  1117,  -10020,  -618180 },	/* Pacific/Kanton */
+	{  1132,  -43800,   348900 },	/* Indian/Cocos */
+	{  1145,  136620,   210180 },	/* Asia/Ashkhabad */
+	{  1160,   88680,   168180 },	/* Asia/Riyadh */
+	{  1172,  171000,    68700 },	/* Europe/Budapest */
+	{  1188,  -31680,    47640 },	/* Africa/Luanda */
+	{  1202, -196200,   572220 },	/* Antarctica/Macquarie */
+	{  1223,  172500,   384780 },	/* Asia/Choibalsan */
+	{  1239,  132587,  -305457 },	/* America/Kentucky/Monticello */
+	{  1267,   25080,   569580 },	/* Pacific/Pohnpei */
+	{  1283,  218580,  -486180 },	/* America/Whitehorse */
+	{  1302,  -83280,  -485820 },	/* Pacific/Gambier */
+	{  1318,  137715,  -308734 },	/* America/Louisville */
+	{  1337, -243240,  -245280 },	/* Antarctica/Rothera */
+	{  1356,   80220,   410940 },	/* Asia/Hong_Kong */
+	{  1371,  157920,    66300 },	/* Europe/Sarajevo */
+	{  1387,  200721,   135424 },	/* Europe/Moscow */
+	{  1401,  103080,  -381900 },	/* America/Chihuahua */
+	{  1419,  -51360,  -614520 },	/* Pacific/Samoa */
+	{  1433,  126600,   120120 },	/* Asia/Nicosia */
+	{  1446,   98880,   322740 },	/* Asia/Thimphu */
+	{  1459,  169080,   513720 },	/* Asia/Sakhalin */
+	{  1473,  231060,  -186240 },	/* America/Nuuk */
+	{  1486,  -18420,   429840 },	/* Asia/Ujung_Pandang */
+	{  1505,  148665,  -311850 },	/* America/Knox_IN */
+	{  1521,  192000,  -217500 },	/* America/Goose_Bay */
+	{  1539,   45900,   162720 },	/* Asia/Aden */
+	{  1549,   66420,  -232620 },	/* America/Tortola */
+	{  1565, -114180,   463920 },	/* Australia/Eucla */
+	{  1581,  112440,   437280 },	/* Asia/Harbin */
+	{  1593,  148665,  -311850 },	/* America/Indiana/Knox */
+	{  1614,   -7020,   108240 },	/* Africa/Kigali */
+	{  1628,   32520,   139320 },	/* Africa/Addis_Ababa */
+	{  1647,  194940,   -16080 },	/* Europe/Isle_of_Man */
+	{  1666,  112440,   437280 },	/* Asia/Shanghai */
+	{  1680,  136631,  -312341 },	/* America/Indiana/Tell_City */
+	{  1706,   52680,  -325860 },	/* America/Guatemala */
+	{  1724,  179580,  -349740 },	/* America/Winnipeg */
+	{  1741,  -63600,   606300 },	/* Pacific/Efate */
+	{  1755,  170580,    30720 },	/* Europe/Zurich */
+	{  1769,   25740,   616320 },	/* Pacific/Majuro */
+	{  1784,  168642,  -365079 },	/* America/North_Dakota/New_Salem */
+	{  1815, -113520,  -246660 },	/* America/Argentina/San_Juan */
+	{  1842,  -97740,  -393960 },	/* Pacific/Easter */
+	{  1857,   37800,  -240960 },	/* America/Caracas */
+	{  1873,  -98880,   550920 },	/* Australia/Queensland */
+	{  1894,  -28980,  -125640 },	/* America/Recife */
+	{  1909,  157140,  -285780 },	/* America/Montreal */
+	{  1926,   66486,  -237982 },	/* America/Puerto_Rico */
+	{  1946,  -55500,   101820 },	/* Africa/Lusaka */
+	{  1960, -164040,  -259440 },	/* America/Coyhaique */
+	{  1978,  161280,   235680 },	/* Asia/Qyzylorda */
+	{  1993,    5580,   397200 },	/* Asia/Kuching */
+	{  2006,  -34800,  -128580 },	/* America/Maceio */
+	{  2021,   21000,  -198600 },	/* America/Paramaribo */
+	{  2040,   61380,  -222480 },	/* America/Antigua */
+	{  2056,  178037,    -9130 },	/* Europe/Guernsey */
+	{  2072,   52560,  -219900 },	/* America/Martinique */
+	{  2091,  185430,     -451 },	/* Europe/Belfast */
+	{  2106,  184380,   184860 },	/* Asia/Oral */
+	{  2116,  -89220,  -235500 },	/* America/Argentina/Salta */
+	{  2140,   83580,  -383100 },	/* America/Mazatlan */
+	{  2157,  121140,   -27300 },	/* Africa/Casablanca */
+	{  2175,  -59400,  -245340 },	/* America/La_Paz */
+	{  2190,   66720,  -260400 },	/* America/Port-au-Prince */
+	{  2213,  205835,  -487087 },	/* America/Sitka */
+	{  2227,  200721,   135424 },	/* W-SU */
+	{  2232,  196860,    91140 },	/* Europe/Vilnius */
+	{  2247,  165780,    52260 },	/* Europe/Ljubljana */
+	{  2264,   83280,  -296520 },	/* Cuba */
+	{  2269,  -87060,  -235080 },	/* America/Jujuy */
+	{  2283,  216600,    89880 },	/* Europe/Helsinki */
+	{  2299,  157140,  -285780 },	/* America/Thunder_Bay */
+	{  2319,  232204,  -595463 },	/* America/Nome */
+	{  2332,  140460,   452700 },	/* Asia/Pyongyang */
+	{  2347,   23340,     9420 },	/* Africa/Porto-Novo */
+	{  2365,  161820,   122760 },	/* Europe/Simferopol */
+	{  2383,  213600,    64980 },	/* Europe/Stockholm */
+	{  2400,   69420,   599820 },	/* Pacific/Wake */
+	{  2413, -195360,  -131520 },	/* Atlantic/South_Georgia */
+	{  2436,  185100,  -205620 },	/* America/Blanc-Sablon */
+	{  2457,  188100,    75600 },	/* Poland */
+	{  2464,  214369,  -503018 },	/* America/Yakutat */
+	{  2480,  211680,  -441720 },	/* America/Fort_Nelson */
+	{  2500,  220385,  -539641 },	/* America/Anchorage */
+	{  2518,  -42060,   155760 },	/* Indian/Comoro */
+	{  2532,   91020,   185520 },	/* Asia/Qatar */
+	{  2543, -119940,  -238860 },	/* America/Argentina/San_Luis */
+	{  2570,  -68100,   171060 },	/* Indian/Antananarivo */
+	{  2590,   19140,   -14520 },	/* Africa/Abidjan */
+	{  2605,  -76440,  -575160 },	/* Pacific/Rarotonga */
+	{  2623,  223200,   466800 },	/* Asia/Yakutsk */
+	{  2636,  118440,    47460 },	/* Africa/Tripoli */
+	{  2651,  203400,   305880 },	/* Asia/Tomsk */
+	{  2662,  143166,  -310169 },	/* America/Indianapolis */
+	{  2683,  192000,   -22500 },	/* Eire */
+	{  2688,  -44880,   471000 },	/* Australia/Darwin */
+	{  2705,  201660,   334200 },	/* Asia/Krasnoyarsk */
+	{  2722,  185640,   165720 },	/* Europe/Saratov */
+	{  2737,   62280,  -225780 },	/* America/St_Kitts */
+	{  2754,  -90240,  -468300 },	/* Pacific/Pitcairn */
+	{  2771,  230640,  -501900 },	/* America/Dawson */
+	{  2786,  -16800,   199680 },	/* Indian/Mahe */
+	{  2798,   16560,  -266700 },	/* America/Bogota */
+	{  2813,  164880,    57480 },	/* Europe/Zagreb */
+	{  2827,   69840,  -356940 },	/* America/Mexico_City */
+	{  2847,  106440,  -375900 },	/* America/Ojinaga */
+	{  2863,  200760,  -432840 },	/* America/Dawson_Creek */
+	{  2884,  -94680,   111960 },	/* Africa/Mbabane */
+	{  2899,  135180,   457080 },	/* Asia/Seoul */
+	{  2910,   17760,  -188400 },	/* America/Cayenne */
+	{  2926,  -51360,  -614520 },	/* Pacific/Pago_Pago */
+	{  2944,  137715,  -308734 },	/* America/Kentucky/Louisville */
+	{  2972,  -12180,   105720 },	/* Africa/Bujumbura */
+	{  2989,  138900,   247680 },	/* Asia/Dushanbe */
+	{  3003,  120060,   159900 },	/* Asia/Baghdad */
+	{  3016,   42660,   -56100 },	/* Africa/Bissau */
+	{  3030,  229440,  -246480 },	/* America/Iqaluit */
+	{  3046,  104640,  -399480 },	/* America/Hermosillo */
+	{  3065, -197280,  -245880 },	/* America/Argentina/Ushuaia */
+	{  3091,  -30780,   452100 },	/* Asia/Dili */
+	{  3101,   13500,    31620 },	/* Africa/Malabo */
+	{  3115,   65040,  -227100 },	/* America/Marigot */
+	{  3131, -121920,   544380 },	/* Australia/Canberra */
+	{  3150,  112440,   437280 },	/* Asia/Chungking */
+	{  3165,  253740,   -79080 },	/* America/Scoresbysund */
+	{  3186,  -22380,   560040 },	/* Pacific/Bougainville */
+	{  3207,  -97740,  -393960 },	/* Chile/EasterIsland */
+	{  3226,  195600,   174240 },	/* Europe/Ulyanovsk */
+	{  3243, -125700,   498900 },	/* Australia/South */
+	{  3259,   55080,  -221040 },	/* America/Dominica */
+	{  3276,  101160,   -55440 },	/* Atlantic/Canary */
+	{  3292,  -72960,   536400 },	/* Australia/Lindeman */
+	{  3311,   99780,   307140 },	/* Asia/Katmandu */
+	{  3325,   19140,   -14520 },	/* Iceland */
+	{  3333,  139492,  -306242 },	/* America/Indiana/Vevay */
+	{  3355,   -3240,  -322560 },	/* Pacific/Galapagos */
+	{  3373,  192120,   301500 },	/* Asia/Barnaul */
+	{  3386,  200400,    45300 },	/* Europe/Copenhagen */
+	{  3404,  112440,   437280 },	/* PRC */
+	{  3408,  124260,   249120 },	/* Asia/Kabul */
+	{  3419,  114410,   126806 },	/* Asia/Jerusalem */
+	{  3434,   60180,  -223980 },	/* America/Montserrat */
+	{  3453,   69840,  -356940 },	/* Mexico/General */
+	{  3468,  114410,   126806 },	/* Asia/Tel_Aviv */
+	{  3482, -259241,     9126 },	/* Antarctica/Troll */
+	{  3499,   -5220,  -174540 },	/* America/Belem */
+	{  3513,   90180,   437400 },	/* ROC */
+	{  3517,  -34320,   576720 },	/* Pacific/Guadalcanal */
+	{  3537,  128356,   503081 },	/* Asia/Tokyo */
+	{  3548,   90180,   437400 },	/* Asia/Taipei */
+	{  3560,   76705,  -568290 },	/* US/Hawaii */
+	{  3570,  139238,  -315103 },	/* America/Indiana/Vincennes */
+	{  3596,  -25920,  -173520 },	/* America/Araguaina */
+	{  3614,  143166,  -310169 },	/* America/Fort_Wayne */
+	{  3633,  152393,  -298965 },	/* America/Detroit */
+	{  3649,   52800,   -62760 },	/* Africa/Dakar */
+	{  3662,  181440,  -376740 },	/* America/Regina */
+	{  3677,  213900,    89100 },	/* Europe/Tallinn */
+	{  3692,  154440,   268560 },	/* Asia/Bishkek */
+	{  3705,   75900,  -312360 },	/* America/Cancun */
+	{  3720, -280200,   599760 },	/* Antarctica/McMurdo */
+	{  3739,  120414,  -403464 },	/* America/Phoenix */
+	{  3755,  -35880,  -244080 },	/* America/Rio_Branco */
+	{  3774,   41580,   377700 },	/* Asia/Phnom_Penh */
+	{  3790,   23220,    12240 },	/* Africa/Lagos */
+	{  3803,  188160,   375600 },	/* Asia/Irkutsk */
+	{  3816,   47160,  -214620 },	/* America/Barbados */
+	{  3833, -246900,   280680 },	/* Antarctica/Davis */
+	{  3850,  157320,    26580 },	/* Europe/Monaco */
+	{  3864,  150660,  -315540 },	/* America/Chicago */
+	{  3880,   43380,  -222300 },	/* America/Grenada */
+	{  3896,   64380,  -226260 },	/* America/St_Barthelemy */
+	{  3918,  158100,    44880 },	/* Europe/San_Marino */
+	{  3936,   90300,  -278460 },	/* America/Nassau */
+	{  3951,  229440,  -246480 },	/* America/Pangnirtung */
+	{  3971,   49320,  -321120 },	/* America/El_Salvador */
+	{  3991,   32700,   602400 },	/* Pacific/Kwajalein */
+	{  4009,   48660,     7620 },	/* Africa/Niamey */
+	{  4023,   66480,  -251640 },	/* America/Santo_Domingo */
+	{  4045,  165960,  -233220 },	/* America/Moncton */
+	{  4061,   77280,  -256080 },	/* America/Grand_Turk */
+	{  4080,  120414,  -403464 },	/* US/Arizona */
+	{  4091,  -13860,  -116700 },	/* Brazil/DeNoronha */
+	{  4108,  157680,   315300 },	/* Asia/Urumqi */
+	{  4120,  147785,  -311771 },	/* America/Indiana/Winamac */
+	{  4144,   74880,  -378900 },	/* America/Bahia_Banderas */
+	{  4167,  -75120,   199680 },	/* Indian/Reunion */
+	{  4182,   38700,   384000 },	/* Asia/Saigon */
+	{  4194,  169200,   103800 },	/* Europe/Chisinau */
+	{  4210,   43620,    54180 },	/* Africa/Ndjamena */
+	{  4226,  -11280,  -216060 },	/* America/Manaus */
+	{  4241,  185430,     -451 },	/* GB */
+	{  4244,  225563,   487994 },	/* Asia/Khandyga */
+	{  4258, -154380,   530340 },	/* Australia/Hobart */
+	{  4275,  181020,  -388200 },	/* America/Swift_Current */
+	{  4297,  -84720,  -167820 },	/* Brazil/East */
+	{  4309,  161400,    73800 },	/* Europe/Belgrade */
+	{  4325,  143061,  -377943 },	/* America/Denver */
+	{  4340,  215700,    38700 },	/* Europe/Oslo */
+	{  4352,   85380,   325500 },	/* Asia/Dhaka */
+	{  4363,   19140,   -14520 },	/* Africa/Timbuktu */
+	{  4379,  -15480,    55080 },	/* Africa/Kinshasa */
+	{  4395,  171240,  -189780 },	/* Canada/Newfoundland */
+	{  4415,   43860,  -248400 },	/* America/Curacao */
+	{  4431,  185430,     -451 },	/* GB-Eire */
+	{  4439,  -47880,  -634200 },	/* Pacific/Wallis */
+	{  4454,  192780,  -408480 },	/* Canada/Mountain */
+	{  4470,   35760,  -302700 },	/* America/Costa_Rica */
+	{  4489,    1200,    24240 },	/* Africa/Sao_Tome */
+	{  4505,  -13380,  -138600 },	/* America/Fortaleza */
+	{  4523,   91080,   199080 },	/* Asia/Dubai */
+	{  4534,   64685,  -276456 },	/* America/Jamaica */
+	{  4550,  -37500,   380580 },	/* Indian/Christmas */
+	{  4567,   79910,   408750 },	/* Asia/Macau */
+	{  4578,  181020,   205800 },	/* Asia/Aqtobe */
+	{  4590,   79910,   408750 },	/* Asia/Macao */
+	{  4601,   64680,   369360 },	/* Asia/Vientiane */
+	{  4616,  128400,   185160 },	/* Iran */
+	{  4621,  -26400,   260700 },	/* Indian/Chagos */
+	{  4635,  -46740,  -138660 },	/* America/Bahia */
+	{  4649,  248810,  -378190 },	/* America/Cambridge_Bay */
+	{  4671, -132720,   629160 },	/* Antarctica/South_Pole */
+	{  4693,  -81240,    61560 },	/* Africa/Windhoek */
+	{  4709,  157009,  -418329 },	/* America/Boise */
+	{  4723,  175531,  -329838 },	/* America/Atikokan */
+	{  4740,  181560,   109860 },	/* Europe/Kiev */
+	{  4752, -102480,  -236820 },	/* America/Catamarca */
+	{  4770,   48480,   521100 },	/* Pacific/Guam */
+	{  4783,  -34200,   529800 },	/* Pacific/Truk */
+	{  4796,   84960,   210900 },	/* Asia/Muscat */
+	{  4808,  191520,   180540 },	/* Europe/Samara */
+	{  4822,  169619,  -364677 },	/* America/North_Dakota/Center */
+	{  4850,  -44880,   471000 },	/* Australia/North */
+	{  4866, -233280,  -230760 },	/* Antarctica/Palmer */
+	{  4884,    6720,  -566400 },	/* Pacific/Kiritimati */
+	{  4903,  -88740,    93300 },	/* Africa/Gaborone */
+	{  4919,  172500,   384780 },	/* Asia/Ulaanbaatar */
+	{  4936,  160740,  -228960 },	/* America/Halifax */
+	{  4952,   26700,   546420 },	/* Pacific/Chuuk */
+	{  4966,  220385,  -539641 },	/* US/Alaska */
+	{  4976, -191340,  -255300 },	/* America/Punta_Arenas */
+	{  4997,  136680,    85380 },	/* Europe/Athens */
+	{  5011,  231060,  -186240 },	/* America/Godthab */
+	{  5027,   38700,   384000 },	/* Asia/Ho_Chi_Minh */
+	{  5044,  179580,  -349740 },	/* Canada/Central */
+	{  5059,  132420,    10980 },	/* Africa/Algiers */
+	{  5074,   43740,  -310620 },	/* America/Managua */
+	{  5090,  147660,   104280 },	/* Asia/Istanbul */
+	{  5104,   49500,   361860 },	/* Asia/Bangkok */
+	{  5117,   34260,   -49380 },	/* Africa/Conakry */
+	{  5132,  204660,   218160 },	/* Asia/Yekaterinburg */
+	{  5151,  144660,   160200 },	/* Asia/Yerevan */
+	{  5164,  193500,   313620 },	/* Asia/Novokuznetsk */
+	{  5182,  268904,  -341385 },	/* America/Resolute */
+	{  5199,   76705,  -568290 },	/* Pacific/Johnston */
+	{  5216,   10140,  -218400 },	/* America/Boa_Vista */
+	{  5234,   54720,   524700 },	/* Pacific/Saipan */
+	{  5249,   24960,   287460 },	/* Asia/Colombo */
+	{  5262,   89520,   241380 },	/* Asia/Karachi */
+	{  5275,  160740,  -228960 },	/* Canada/Atlantic */
+	{  5291, -158220,  -635580 },	/* NZ-CHAT */
+	{  5299,  -84720,  -167820 },	/* America/Sao_Paulo */
+	{  5317,   53700,   -84660 },	/* Atlantic/Cape_Verde */
+	{  5337, -136140,   521880 },	/* Australia/Victoria */
+	{  5356,  159960,    93960 },	/* Europe/Bucharest */
+	{  5373,   81120,   318120 },	/* Asia/Kolkata */
+	{  5386,   80220,   410940 },	/* Hongkong */
+	{  5395, -125700,   498900 },	/* Australia/Adelaide */
+	{  5414,  147660,   104280 },	/* Turkey */
+	{  5421,  108180,   112500 },	/* Africa/Cairo */
+	{  5434,  101580,  -638520 },	/* Pacific/Midway */
+	{  5449,  -68460,  -611700 },	/* Pacific/Niue */
+	{  5462, -102480,  -236820 },	/* America/Argentina/ComodRivadavia */
+	{  5495,   -8760,  -197520 },	/* America/Santarem */
+	{  5512,  -34200,   529800 },	/* Pacific/Yap */
+	{  5524,   65160,   -57420 },	/* Africa/Nouakchott */
+	{  5542,   19980,     -780 },	/* Africa/Accra */
+	{  5555,  138571,  -314203 },	/* America/Indiana/Petersburg */
+	{  5582,  126600,   120120 },	/* Europe/Nicosia */
+	{  5597,  209887,  -483911 },	/* America/Juneau */
+	{  5612,  145380,   179460 },	/* Asia/Baku */
+	{  5622,  176760,  -419460 },	/* America/Creston */
+	{  5638,  136620,   210180 },	/* Asia/Ashgabat */
+	{  5652,  157140,  -285780 },	/* America/Nipigon */
+	{  5668,   41760,   155340 },	/* Africa/Djibouti */
+	{  5684,  186768,  -635969 },	/* US/Aleutian */
+	{  5696,  121980,   127800 },	/* Asia/Beirut */
+	{  5708, -132720,   629160 },	/* Pacific/Auckland */
+	{  5725,  -22200,   384480 },	/* Asia/Jakarta */
+	{  5738,  -35880,  -244080 },	/* America/Porto_Acre */
+	{  5757,   81120,   318120 },	/* Asia/Calcutta */
+	{  5771,  223260,   -24360 },	/* Atlantic/Faeroe */
+	{  5787,  157140,  -285780 },	/* Canada/Eastern */
+	{  5802,    4620,   373860 },	/* Singapore */
+	{  5812,  132480,    36660 },	/* Africa/Tunis */
+	{  5825, -121920,   544380 },	/* Australia/Sydney */
+	{  5842,  139380,   -32880 },	/* Portugal */
+	{  5851,   15720,    66900 },	/* Africa/Bangui */
+	{  5865,  198120,   298500 },	/* Asia/Novosibirsk */
+	{  5882,  143061,  -377943 },	/* US/Mountain */
+	{  5894,  147660,   104280 },	/* Europe/Istanbul */
+	{  5910,  -51360,  -614520 },	/* US/Samoa */
+	{  5919, -106080,    99000 },	/* Africa/Maseru */
+	{  5933,  192780,  -408480 },	/* America/Edmonton */
+	{  5950,  150660,  -315540 },	/* US/Central */
+	{  5961,  -34320,   576720 },	/* Pacific/Ponape */
+	{  5976,    1140,   116700 },	/* Africa/Kampala */
+	{  5991,   85380,   325500 },	/* Asia/Dacca */
+	{  6002,  135840,   -92400 },	/* Atlantic/Azores */
+	{  6018,    1380,    34020 },	/* Africa/Libreville */
+	{  6036,  173580,    58800 },	/* Europe/Vienna */
+	{  6050,  246059,  -481380 },	/* America/Inuvik */
+	{  6065,  189000,    48120 },	/* Europe/Berlin */
+	{  6079, -136140,   521880 },	/* Australia/Melbourne */
+	{  6099,  122588,  -425674 },	/* US/Pacific */
+	{  6110,  223260,   -24360 },	/* Atlantic/Faroe */
+	{  6125,  148800,   249480 },	/* Asia/Tashkent */
+	{  6139,  198457,  -473675 },	/* America/Metlakatla */
+	{  6158,  157140,  -285780 },	/* America/Toronto */
+	{  6174,   44520,    -5460 },	/* Africa/Ouagadougou */
+	{  6193,  188100,    75600 },	/* Europe/Warsaw */
+	{  6207,   38340,  -221460 },	/* America/Port_of_Spain */
+	{  6229,   22680,   -38820 },	/* Africa/Monrovia */
+	{  6245,  218580,  -486180 },	/* Canada/Yukon */
+	{  6258,   50460,  -219600 },	/* America/St_Lucia */
+	{  6275,   63000,  -317520 },	/* America/Belize */
+	{  6290,   60420,   346200 },	/* Asia/Rangoon */
+	{  6303,   47340,  -220440 },	/* America/St_Vincent */
+	{  6322, -104580,   604680 },	/* Pacific/Norfolk */
+	{  6338,  117120,  -421260 },	/* America/Ensenada */
+	{  6355,  -31560,  -230040 },	/* America/Porto_Velho */
+	{  6375,  145440,   -13260 },	/* Europe/Madrid */
+	{  6389,  186768,  -635969 },	/* America/Atka */
+	{  6402,  117120,  -421260 },	/* Mexico/BajaNorte */
+	{  6419,  -56820,   126000 },	/* Africa/Blantyre */
+	{  6435,  172860,   329940 },	/* Asia/Hovd */
+	{  6445,  -87060,  -235080 },	/* America/Argentina/Jujuy */
+	{  6469,  171240,  -189780 },	/* America/St_Johns */
+	{  6486,    7440,   163320 },	/* Africa/Mogadishu */
+	{  6503,  150840,    44940 },	/* Europe/Rome */
+	{  6515,  129240,    52260 },	/* Europe/Malta */
+	{  6528,   75480,  -322620 },	/* America/Merida */
+	{  6543,  153000,     5460 },	/* Europe/Andorra */
+	{  6558,  162388,  -315411 },	/* America/Menominee */
+	{  6576,   52512,   435484 },	/* Asia/Manila */
+	{  6588,  166860,   172980 },	/* Europe/Astrakhan */
+	{  6605,   98880,   322740 },	/* Asia/Thimbu */
+	{  6617, -238620,   397860 },	/* Antarctica/Casey */
+	{  6634,  157680,   315300 },	/* Asia/Kashgar */
+	{  6647, -113040,  -231060 },	/* America/Cordoba */
+	{  6663, -125673,  -202365 },	/* America/Montevideo */
+	{  6682,  -57300,   -20520 },	/* Atlantic/St_Helena */
+	{  6701,   48480,   -59940 },	/* Africa/Banjul */
+	{  6715,  181560,   109860 },	/* Europe/Uzhgorod */
+	{  6731,  -56100,  -201900 },	/* America/Cuiaba */
+	{  6746,  166320,  -215820 },	/* America/Glace_Bay */
+	{  6764,   30600,   -47700 },	/* Africa/Freetown */
+	{  6780,   45540,   -28800 },	/* Africa/Bamako */
+	{  6794,   97740,   -47520 },	/* Africa/El_Aaiun */
+	{  6810,  175440,   159900 },	/* Europe/Volgograd */
+	{  6827,  -13860,  -116700 },	/* America/Noronha */
+	{  6843,   76705,  -568290 },	/* Pacific/Honolulu */
+	{  6860, -113580,   572700 },	/* Australia/LHI */
+	{  6874,  150180,   161340 },	/* Asia/Tbilisi */
+	{  6887,  -15360,    55020 },	/* Africa/Brazzaville */
+	{  6906,   93000,  -351000 },	/* America/Matamoros */
+	{  6924,  -96540,  -234780 },	/* America/Argentina/Tucuman */
+	{  6950,  115020,   129360 },	/* Asia/Amman */
+	{  6961,  138152,  -310841 },	/* America/Indiana/Marengo */
+	{  6985,   60420,   346200 },	/* Asia/Yangon */
+	{  6997,  169620,   186960 },	/* Asia/Atyrau */
+	{  7009,  142800,   240480 },	/* Asia/Samarkand */
+	{  7024,  117120,  -421260 },	/* America/Tijuana */
+	{  7040,  -80160,   599220 },	/* Pacific/Noumea */
+	{  7055,  116220,  -233160 },	/* Atlantic/Bermuda */
+	{  7072,  191520,   229020 },	/* Asia/Qostanay */
+	{  7086,  -10020,  -618180 },	/* Pacific/Enderbury */
+	{  7104,   56160,   117120 },	/* Africa/Khartoum */
+	{  7120, -115020,   417060 },	/* Australia/Perth */
+	{  7136,   64985,  -226970 },	/* America/Lower_Princes */
+	{  7158,  -72600,   207000 },	/* Indian/Mauritius */
+	{  7175, -115020,   509220 },	/* Australia/Broken_Hill */
+	{  7197,   92400,  -361140 },	/* America/Monterrey */
+	{  7215,   11400,   366120 },	/* Asia/Kuala_Lumpur */
+	{  7233,  179580,  -349740 },	/* America/Rainy_River */
+	{  7253,  178560,    22140 },	/* Europe/Luxembourg */
+	{  7271,  177360,  -443220 },	/* America/Vancouver */
+	{  7289,  232417,   515616 },	/* Asia/Ust-Nera */
+	{  7303, -154380,   530340 },	/* Australia/Tasmania */
+	{  7322,  177360,  -443220 },	/* Canada/Pacific */
+	{  7337,  117120,  -421260 },	/* America/Santa_Isabel */
+	{  7358,   69480,  -292980 },	/* America/Cayman */
+	{  7373,  169740,    34260 },	/* Europe/Vaduz */
+	{  7386,  181560,   109860 },	/* Europe/Kyiv */
+	{  7398,  120600,   130680 },	/* Asia/Damascus */
+	{  7412,  187380,   408480 },	/* Asia/Chita */
+	{  7423,   43743,  -245796 },	/* America/Kralendijk */
+	{  7442,  155400,   474960 },	/* Asia/Vladivostok */
+	{  7459,  -24000,  -251520 },	/* America/Eirunepe */
+	{  7476,  -24480,   141420 },	/* Africa/Dar_es_Salaam */
+	{  7497,  151140,    77160 },	/* Europe/Skopje */
+	{  7511,  192780,  -408480 },	/* America/Yellowknife */
+	{  7531,  105600,   172740 },	/* Asia/Kuwait */
+	{  7543,   17760,   413700 },	/* Asia/Brunei */
+	{  7555,  169200,   103800 },	/* Europe/Tiraspol */
+	{  7571,    5100,   622800 },	/* Pacific/Tarawa */
+	{  7586, -120420,  -254400 },	/* Chile/Continental */
+	{  7604,  113400,   124080 },	/* Asia/Gaza */
+	{  7614,  210960,   178740 },	/* Europe/Kirov */
+	{  7627,  -34200,   529800 },	/* Pacific/Port_Moresby */
+	{  7648,   -4620,   132540 },	/* Africa/Asmera */
+	{  7662,  -65280,   642300 },	/* Pacific/Fiji */
+	{  7675, -115020,   509220 },	/* Australia/Yancowinna */
+	{  7696,  233100,   638940 },	/* Asia/Anadyr */
+	{  7708,  -11280,  -216060 },	/* Brazil/West */
+	{  7720,   22080,     4380 },	/* Africa/Lome */
+	{  7732, -185880,  -249180 },	/* America/Argentina/Rio_Gallegos */
+	{  7763,  143166,  -310169 },	/* US/East-Indiana */
+	{  7779,   94980,   182100 },	/* Asia/Bahrain */
+	{  7792,   66486,  -237982 },	/* America/Virgin */
+	{  7807,   24480,  -209400 },	/* America/Guyana */
+	{  7822,  143061,  -377943 },	/* Navajo */
+	{  7829, -115020,   417060 },	/* Australia/West */
+	{  7844,  112440,   437280 },	/* Asia/Chongqing */
+	{  7859,   50760,  -313980 },	/* America/Tegucigalpa */
+	{  7879,  -73620,  -196620 },	/* America/Campo_Grande */
+	{  7900,  152393,  -298965 },	/* US/Michigan */
+	{  7912,  -64200,   111780 },	/* Africa/Harare */
+	{  7926,    -120,   393600 },	/* Asia/Pontianak */
+	{  7941,  173340,    61620 },	/* Europe/Bratislava */
+	{  7959,  -94500,   100800 },	/* Africa/Johannesburg */
+	{  7979,  186768,  -635969 },	/* America/Adak */
+	{  7992, -105960,  -240660 },	/* America/Argentina/La_Rioja */
+	{  8019,   17460,   113820 },	/* Africa/Juba */
+	{  8031,  188520,    17640 },	/* Europe/Amsterdam */
+	{  8048, -124560,  -210420 },	/* America/Argentina/Buenos_Aires */
+	{  8079, -132720,   629160 },	/* NZ */
+	{  8082,  185430,     -451 },	/* Europe/London */
+	{  8096,  -46020,   162840 },	/* Indian/Mayotte */
+	{  8111,  108180,   112500 },	/* Egypt */
+	{  8117,   -4620,   132540 },	/* Africa/Nairobi */
+	{  8132,  129180,   -19140 },	/* Africa/Ceuta */
+	{  8145,   55200,   139980 },	/* Africa/Asmara */
+	{  8159,  194040,    99240 },	/* Europe/Minsk */
+	{  8172,  -43380,  -277380 },	/* America/Lima */
+	{  8185,  122588,  -425674 },	/* America/Los_Angeles */
+	{  8205, -121920,   544380 },	/* Australia/ACT */
+	{  8219,  -49800,  -618240 },	/* Pacific/Apia */
+	{  8232,  181440,  -376740 },	/* Canada/Saskatchewan */
+	{  8252, -124560,  -210420 },	/* America/Buenos_Aires */
+	{  8273,  177061,    -7584 },	/* Europe/Jersey */
+	{  8287,  128400,   185160 },	/* Asia/Tehran */
+	{  8299, -118380,  -247740 },	/* America/Argentina/Mendoza */
+	{  8325,   -7800,  -287400 },	/* America/Guayaquil */
+	{  8343,  280800,    57600 },	/* Arctic/Longyearbyen */
+	{  8363,  113520,   126342 },	/* Asia/Hebron */
+	{  8375,   45000,  -251880 },	/* America/Aruba */
+	{  8389,  196980,    73800 },	/* Europe/Kaliningrad */
+	{  8408, -243360,   226380 },	/* Antarctica/Mawson */
+	{  8426,  118440,    47460 },	/* Libya */
+	{  8432,  -98880,   550920 },	/* Australia/Brisbane */
+	{  8451,   99780,   307140 },	/* Asia/Kathmandu */
+	{  8466, -120420,  -254400 },	/* America/Santiago */
+	{  8483,   83280,  -296520 },	/* America/Havana */
+	{  8498,   15000,   264600 },	/* Indian/Maldives */
+	{  8514, -186120,  -208260 },	/* Atlantic/Stanley */
+	{  8531, -158220,  -635580 },	/* Pacific/Chatham */
+	{  8547,  169380,  -202800 },	/* America/Miquelon */
+	{  8564,  160260,   180960 },	/* Asia/Aqtau */
+	{  8575, -154380,   530340 },	/* Australia/Currie */
+	{  8592,  214440,   542880 },	/* Asia/Magadan */
+	{  8605,  -30660,   645180 },	/* Pacific/Funafuti */
+};
+
+static const uint16_t tz_disp[TZ_BUCKETS] = {
+	5, 144, 29, 56, 129, 1, 164, 26, 1, 8, 43, 42,
+	1, 6, 5, 197, 119, 6, 6, 12, 273, 14, 18, 111,
+	10, 0, 154, 2, 3, 15, 238, 90, 84, 88, 81, 88,
+	160, 4, 1, 49, 50, 66, 338, 1, 1, 1056, 532, 34,
+	44, 32, 25, 171, 1049, 108, 81, 66, 66, 11, 321, 278,
+	9, 30, 130, 1, 94, 3, 2, 226, 62, 2, 66, 64,
+	2, 366, 16, 127, 7, 41, 168, 4, 2, 101, 282, 29,
+	233, 188, 84, 1, 15, 671, 5, 911, 30, 1, 33, 137,
+	378, 4, 2, 1, 21, 0, 1, 14, 11, 691, 19, 25,
+	551, 18, 81, 1402, 329, 273, 1, 109, 65, 27, 1645, 191,
+	1, 1, 323, 37, 1259, 12, 808, 258, 1, 764, 638, 498,
+	738, 97, 3378, 15
+};
+
+#define TZ_CANON    418
+
+/* Slots in tz_zone[] of the zones in zone.tab, i.e. not aliases */
+static const uint16_t tz_canon[TZ_CANON] = {
+	0, 1, 2, 3, 6, 7, 8, 9, 10, 11, 13, 14,
+	17, 18, 19, 21, 22, 26, 27, 29, 30, 31, 32, 33,
+	34, 35, 36, 37, 39, 40, 41, 42, 46, 47, 48, 50,
+	51, 52, 54, 55, 56, 57, 58, 59, 60, 61, 62, 64,
+	65, 66, 67, 68, 69, 70, 72, 73, 74, 75, 77, 78,
+	79, 80, 82, 83, 84, 85, 86, 88, 89, 90, 91, 94,
+	95, 96, 97, 99, 100, 101, 102, 103, 104, 105, 106, 107,
+	108, 109, 110, 111, 112, 113, 115, 117, 118, 119, 120, 121,
+	122, 123, 124, 125, 126, 128, 129, 130, 131, 132, 133, 134,
+	136, 137, 140, 142, 143, 144, 145, 146, 147, 148, 149, 151,
+	152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 165,
+	166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177,
+	178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189,
+	190, 191, 194, 195, 197, 199, 200, 201, 204, 205, 206, 207,
+	209, 210, 211, 214, 215, 217, 218, 219, 221, 222, 224, 225,
+	226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237,
+	238, 239, 240, 241, 242, 243, 245, 246, 247, 248, 249, 250,
+	253, 254, 255, 256, 258, 259, 260, 262, 263, 264, 266, 267,
+	268, 269, 271, 273, 275, 277, 278, 279, 280, 281, 282, 283,
+	284, 286, 288, 289, 290, 292, 293, 294, 297, 299, 300, 301,
+	303, 304, 305, 306, 307, 308, 310, 311, 313, 315, 316, 318,
+	319, 320, 321, 322, 323, 325, 326, 327, 328, 331, 332, 334,
+	335, 337, 339, 340, 341, 343, 345, 346, 347, 349, 350, 351,
+	352, 354, 356, 357, 358, 364, 365, 367, 368, 370, 372, 373,
+	376, 378, 379, 380, 381, 382, 383, 385, 386, 387, 388, 389,
+	390, 391, 392, 394, 395, 397, 398, 400, 401, 404, 405, 406,
+	407, 408, 409, 410, 411, 412, 413, 414, 415, 417, 420, 421,
+	422, 424, 425, 426, 427, 428, 429, 430, 431, 433, 434, 435,
+	436, 437, 438, 439, 440, 441, 442, 443, 444, 445, 447, 448,
+	449, 450, 451, 452, 453, 455, 456, 457, 461, 462, 463, 464,
+	465, 466, 467, 468, 469, 470, 472, 473, 475, 477, 478, 479,
+	481, 483, 485, 486, 488, 490, 494, 495, 497, 498, 499, 500,
+	501, 502, 503, 504, 505, 507, 508, 510, 511, 512, 513, 514,
+	515, 517, 520, 521, 522, 523, 524, 525, 526, 527, 528, 530,
+	531, 532, 533, 534, 535, 536, 537, 538, 540, 541
 };
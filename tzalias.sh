@@ -7,21 +7,166 @@
 #
 # Download and unpack the archive into a separate directory, then run
 # this script from that directory.  The output is the file tzalias.h
+# Alternatively, give the path to an installed zoneinfo directory with
+# tzdata.zi and zone.tab, e.g. /usr/share/zoneinfo
+#
+# The header holds the coordinates of every zone in zone.tab, and of
+# every alias (Link) resolved through any number of hops to such a
+# zone, for lookup by name with a minimal perfect hash.  Names are kept
+# in one string pool and referred to by offset, so the tables contain
+# no pointers and need no relocations.  The hash function must match
+# tz_hash() in zone.c:
+#
+#	h = seed; for each c: h = (h * 33 + c) % 16777259
+#
+# A key's bucket is hash(key, 0) % TZ_BUCKETS and its slot in tz_zone[]
+# is hash(key, tz_disp[bucket]) % TZ_ZONES.  The slots of the zone.tab
+# zones, without aliases, are listed in tz_canon[] for reverse lookup of
+# the nearest zone to a position.  Only POSIX awk is needed,
+# the arithmetic stays below 2^31 so no bitwise operations are used.
 #
 FILES="africa australasia backward backzone europe etcetera northamerica southamerica"
 HEADER=tzalias.h
+DIR=${1:-.}
+
+if [ -f "$DIR/tzdata.zi" ]; then
+	LINKS=$(awk '$1 == "L" { print "L", $2, $3 }' "$DIR/tzdata.zi")
+	VERSION=$(awk '$2 == "version" { print $3; exit }' "$DIR/tzdata.zi")
+else
+	LINKS=$(cd "$DIR" && cat $FILES | awk '$1 == "Link" { print "L", $2, $3 }')
+	VERSION=$(cat "$DIR/version" 2>/dev/null)
+fi
+ZONES=$(awk '!/^#/ { print "Z", $3, $2 }' "$DIR/zone.tab")
+
+printf "%s\n%s\n" "$LINKS" "$ZONES" | awk -v version="$VERSION" '
+function hash(s, seed,    h, i) {
+	h = seed
+	for (i = 1; i <= length(s); i++)
+		h = (h * 33 + ord[substr(s, i, 1)]) % 16777259
+	return h
+}
+
+# +DDMM, +DDMMSS, +DDDMM or +DDDMMSS to seconds of arc
+function arcsec(s, deg,    sign, v) {
+	sign = substr(s, 1, 1) == "-" ? -1 : 1
+	v = substr(s, 2, deg) * 3600 + substr(s, 2 + deg, 2) * 60
+	if (length(s) > 3 + deg)
+		v += substr(s, 4 + deg, 2)
+	return sign * v
+}
+
+BEGIN {
+	for (i = 32; i < 127; i++)
+		ord[sprintf("%c", i)] = i
+}
+
+$1 == "L" {
+	if (!($3 in target))
+		link[nl++] = $3
+	target[$3] = $2
+}
+
+$1 == "Z" {
+	coord = $3
+	for (i = 2; i <= length(coord); i++) {
+		c = substr(coord, i, 1)
+		if (c == "+" || c == "-")
+			break
+	}
+	key[n++] = $2
+	lat[$2] = arcsec(substr(coord, 1, i - 1), 2)
+	lon[$2] = arcsec(substr(coord, i), 3)
+}
+
+END {
+	# Every zone, and every link that resolves to one
+	nz = n
+	for (i = 0; i < nl; i++) {
+		l = link[i]
+		if (l in lat)
+			continue
+		t = l
+		for (hops = 0; hops < 16 && (t in target) && !(t in lat); hops++)
+			t = target[t]
+		if (!(t in lat))
+			continue
+		lat[l] = lat[t]
+		lon[l] = lon[t]
+		key[n++] = l
+	}
+
+	# Hash and displace, largest buckets first
+	nb = int(n / 4) + 1
+	max = 0
+	for (i = 0; i < n; i++) {
+		b = hash(key[i], 0) % nb
+		bucket[b, size[b]++] = i
+		if (size[b] > max)
+			max = size[b]
+	}
+	for (s = max; s > 0; s--) {
+		for (b = 0; b < nb; b++) {
+			if (size[b] != s)
+				continue
+			for (d = 1; ; d++) {
+				ok = 1
+				for (j = 0; j < s && ok; j++) {
+					k = hash(key[bucket[b, j]], d) % n
+					if ((k in slot) || (k in tried))
+						ok = 0
+					tried[k] = 1
+				}
+				for (k in tried)
+					delete tried[k]
+				if (ok)
+					break
+			}
+			disp[b] = d
+			for (j = 0; j < s; j++)
+				slot[hash(key[bucket[b, j]], d) % n] = bucket[b, j]
+		}
+	}
+
+	printf "/* This is a generated file, see tzalias.sh to update it */\n"
+	if (version != "")
+		printf "/* tzdata version %s */\n", version
+	printf "\n#include <stdint.h>\n\n"
+	printf "#define TZ_ZONES    %d\n", n
+	printf "#define TZ_BUCKETS  %d\n\n", nb
+
+	printf "static const char tz_pool[] =\n"
+	off = 0
+	for (k = 0; k < n; k++) {
+		name = key[slot[k]]
+		pos[k] = off
+		off += length(name) + 1
+		printf "\t\"%s\\0\"%s\n", name, k == n - 1 ? ";" : ""
+	}
 
-echo "/* This is a generated file, see tzalias.sh to update it */" >$HEADER
-echo ""                  >>$HEADER
-echo "struct tz_alias {" >>$HEADER
-echo "	char *name;"     >>$HEADER
-echo "	char *alias;"    >>$HEADER
-echo "} tzalias[] = {"   >>$HEADER
+	printf "\n/* Name offset in tz_pool[], latitude and longitude in seconds of arc */\n"
+	printf "static const struct tz_zone {\n"
+	printf "\tuint32_t name;\n"
+	printf "\tint32_t  lat, lon;\n"
+	printf "} tz_zone[TZ_ZONES] = {\n"
+	for (k = 0; k < n; k++) {
+		name = key[slot[k]]
+		printf "\t{ %5d, %7d, %8d },\t/* %s */\n", pos[k], lat[name], lon[name], name
+	}
+	printf "};\n\n"
 
-cat $FILES | awk '
-/^Link\s*([^\s]*)\s([^\s]*)/ {				\
-	printf "\t{ \"%s\", \"%s\" },\n", $3, $2;	\
-} ' | sort               >>$HEADER
+	printf "static const uint16_t tz_disp[TZ_BUCKETS] = {"
+	for (b = 0; b < nb; b++)
+		printf "%s%s%d", b ? "," : "", b % 12 ? " " : "\n\t", (b in disp) ? disp[b] : 0
+	printf "\n};\n\n"
 
-#echo "	{ NULL, NULL }"  >>$HEADER
-echo "};"                >>$HEADER
+	printf "#define TZ_CANON    %d\n\n", nz
+	printf "/* Slots in tz_zone[] of the zones in zone.tab, i.e. not aliases */\n"
+	printf "static const uint16_t tz_canon[TZ_CANON] = {"
+	for (j = k = 0; k < n; k++) {
+		if (slot[k] >= nz)
+			continue
+		printf "%s%s%d", j ? "," : "", j % 12 ? " " : "\n\t", k
+		j++
+	}
+	printf "\n};\n"
+}' >$HEADER
@@ -0,0 +1,185 @@
+/*
+
+Coordinates of time zones, by name
+
+The table in tzalias.h is generated by tzalias.sh from zone.tab and the
+Link lines of the IANA tzdata, with all aliases resolved to a zone.  It
+is a minimal perfect hash, so a lookup is one hash of the name, a final
+strcmp() to reject unknown names, and no file I/O.
+
+The reverse, the zone nearest to a position, uses a k-d tree over the
+zone.tab zones as unit vectors in 3D, which avoids the wrap-around at
+the date line and the poles.  Euclidean distance between unit vectors
+grows with the great circle distance, so the nearest point in 3D is
+also the nearest on the sphere.  The tree is an array sorted in place
+around the median of each level, built once, at first use.
+
+Released to the public domain
+
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sunriset.h"
+#include "tzalias.h"
+
+/* Must match hash() in tzalias.sh */
+static uint32_t tz_hash(const char *s, uint32_t seed)
+{
+	uint32_t h = seed;
+
+	while (*s)
+		h = (h * 33 + (unsigned char)*s++) % 16777259;
+
+	return h;
+}
+
+int sunriset_zone( const char *name, double *lon, double *lat )
+{
+	const struct tz_zone *z;
+	uint32_t b;
+
+	if (!name)
+		return 0;
+
+	/* POSIX TZ may be ":Area/Location" */
+	if (*name == ':')
+		name++;
+
+	b = tz_hash(name, 0) % TZ_BUCKETS;
+	z = &tz_zone[tz_hash(name, tz_disp[b]) % TZ_ZONES];
+	if (strcmp(&tz_pool[z->name], name))
+		return 0;
+
+	*lat = z->lat / 3600.0;
+	*lon = z->lon / 3600.0;
+
+	return 1;
+}
+
+struct point {
+	double   v[3];
+	uint16_t slot;		/* In tz_zone[] */
+};
+
+static struct point tree[TZ_CANON];
+static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+static void unit(double lon, double lat, double v[3])
+{
+	v[0] = cosd(lat) * cosd(lon);
+	v[1] = cosd(lat) * sind(lon);
+	v[2] = sind(lat);
+}
+
+static void swap(struct point *a, struct point *b)
+{
+	struct point tmp = *a;
+
+	*a = *b;
+	*b = tmp;
+}
+
+/* Partially sort lo..hi-1 so that the median on axis ends up at the middle */
+static void select_median(size_t lo, size_t hi, int axis)
+{
+	size_t mid = lo + (hi - lo) / 2;
+
+	while (hi - lo > 1) {
+		double pivot;
+		size_t i, k;
+
+		swap(&tree[lo + (hi - lo) / 2], &tree[hi - 1]);
+		pivot = tree[hi - 1].v[axis];
+		for (i = k = lo; i < hi - 1; i++) {
+			if (tree[i].v[axis] < pivot)
+				swap(&tree[i], &tree[k++]);
+		}
+		swap(&tree[k], &tree[hi - 1]);
+
+		if (k == mid)
+			break;
+		if (k < mid)
+			lo = k + 1;
+		else
+			hi = k;
+	}
+}
+
+static void build(size_t lo, size_t hi, int axis)
+{
+	size_t mid = lo + (hi - lo) / 2;
+
+	if (hi - lo < 2)
+		return;
+
+	select_median(lo, hi, axis);
+	build(lo, mid, (axis + 1) % 3);
+	build(mid + 1, hi, (axis + 1) % 3);
+}
+
+static void init(void)
+{
+	size_t i;
+
+	for (i = 0; i < TZ_CANON; i++) {
+		const struct tz_zone *z = &tz_zone[tz_canon[i]];
+
+		unit(z->lon / 3600.0, z->lat / 3600.0, tree[i].v);
+		tree[i].slot = tz_canon[i];
+	}
+	build(0, TZ_CANON, 0);
+}
+
+static void search(size_t lo, size_t hi, int axis, const double v[3],
+		   size_t *best, double *dist)
+{
+	size_t mid = lo + (hi - lo) / 2;
+	double d, dx, dy, dz;
+
+	if (lo >= hi)
+		return;
+
+	dx = tree[mid].v[0] - v[0];
+	dy = tree[mid].v[1] - v[1];
+	dz = tree[mid].v[2] - v[2];
+	d  = dx * dx + dy * dy + dz * dz;
+	if (d < *dist) {
+		*dist = d;
+		*best = mid;
+	}
+
+	/* Near side first, the far side only if the splitting plane is closer */
+	d = v[axis] - tree[mid].v[axis];
+	if (d < 0) {
+		search(lo, mid, (axis + 1) % 3, v, best, dist);
+		if (d * d < *dist)
+			search(mid + 1, hi, (axis + 1) % 3, v, best, dist);
+	} else {
+		search(mid + 1, hi, (axis + 1) % 3, v, best, dist);
+		if (d * d < *dist)
+			search(lo, mid, (axis + 1) % 3, v, best, dist);
+	}
+}
+
+const char *sunriset_zone_nearest( double lon, double lat )
+{
+	double v[3], dist = HUGE_VAL;
+	size_t best = 0;
+
+	pthread_once(&once, init);
+
+	unit(lon, lat, v);
+	search(0, TZ_CANON, 0, v, &best, &dist);
+
+	return &tz_pool[tz_zone[tree[best].slot].name];
+}
+
+/**
+ * Local Variables:
+ *  indent-tabs-mode: t
+ *  c-file-style: "linux"
+ * End:
+ */